@@ -0,0 +1,173 @@
+/* Copyright 2016 Erik Perillo */
+
+/*
+Microbenchmark of the indexed heaps in indexed_heap.h on the decrease-key
+patterns of prim (complete euclidean graph: every pop is followed by a
+scan that decreases the keys of many vertices) and dijkstra (sparse random
+graph with small integer weights: few decreases per pop).
+usage: heap_bench [n_prim_vertices] [n_dijkstra_vertices]
+*/
+
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include "indexed_heap.h"
+
+//Returns a list 0, 1, ..., n-1.
+std::vector<int> seq(int n)
+{
+    std::vector<int> vec(n);
+
+    for(int i=0; i<n; i++)
+        vec[i] = i;
+
+    return vec;
+}
+
+//Prim on complete graph over points (xs, ys). Returns total cost.
+template <class heap_type>
+double prim(const std::vector<double>& xs, const std::vector<double>& ys)
+{
+    int n = (int)xs.size();
+    std::vector<double> keys(n, std::numeric_limits<double>::infinity());
+    double total = 0.0;
+
+    keys[0] = 0.0;
+    heap_type queue(seq(n), keys);
+
+    while(!queue.empty())
+    {
+        int u = queue.pop();
+        total += keys[u];
+
+        for(int v=0; v<n; v++)
+        {
+            if(!queue.contains(v))
+                continue;
+
+            double cost = std::sqrt((xs[u] - xs[v])*(xs[u] - xs[v]) +
+                (ys[u] - ys[v])*(ys[u] - ys[v]));
+            if(cost < keys[v])
+            {
+                keys[v] = cost;
+                queue.update_key(v, cost);
+            }
+        }
+    }
+
+    return total;
+}
+
+//Dijkstra from vertex 0 on graph in compressed adjacency form.
+//Returns sum of distances of reachable vertices.
+template <class heap_type>
+long dijkstra(const std::vector<int>& starts, const std::vector<int>& targets,
+    const std::vector<int>& weights)
+{
+    int n = (int)starts.size() - 1;
+    std::vector<int> dists(n, std::numeric_limits<int>::max());
+    heap_type queue(n);
+    long total = 0;
+
+    dists[0] = 0;
+    queue.push(0, 0);
+
+    while(!queue.empty())
+    {
+        int u = queue.pop();
+        total += dists[u];
+
+        for(int i=starts[u]; i<starts[u+1]; i++)
+        {
+            int v = targets[i];
+            int dist = dists[u] + weights[i];
+
+            if(dist >= dists[v])
+                continue;
+            dists[v] = dist;
+            if(queue.contains(v))
+                queue.update_key(v, dist);
+            else
+                queue.push(v, dist);
+        }
+    }
+
+    return total;
+}
+
+//Runs prim with prim_heap_type and dijkstra with dijkstra_heap_type
+//(the same kind of heap, with double and int keys) and prints times.
+template <class prim_heap_type, class dijkstra_heap_type>
+void bench(const char* name,
+    const std::vector<double>& xs, const std::vector<double>& ys,
+    const std::vector<int>& starts, const std::vector<int>& targets,
+    const std::vector<int>& weights)
+{
+    clock_t start;
+    double prim_secs, dijkstra_secs;
+    double prim_total;
+    long dijkstra_total;
+
+    start = clock();
+    prim_total = prim<prim_heap_type>(xs, ys);
+    prim_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    dijkstra_total = dijkstra<dijkstra_heap_type>(starts, targets, weights);
+    dijkstra_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << std::setw(10) << name
+        << std::setw(12) << std::fixed << std::setprecision(4) << prim_secs
+        << std::setw(14) << dijkstra_secs
+        << "   (" << std::setprecision(1) << prim_total << ", "
+        << dijkstra_total << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int n_prim = (argc > 1)?atoi(argv[1]):4000;
+    int n_dijkstra = (argc > 2)?atoi(argv[2]):1000000;
+    int degree = 8;
+    std::vector<double> xs(n_prim), ys(n_prim);
+    std::vector<int> starts(n_dijkstra + 1), targets, weights;
+
+    srand(42);
+    for(int i=0; i<n_prim; i++)
+    {
+        xs[i] = rand() % 100000;
+        ys[i] = rand() % 100000;
+    }
+    for(int u=0; u<n_dijkstra; u++)
+    {
+        starts[u] = (int)targets.size();
+        for(int j=0; j<degree; j++)
+        {
+            targets.push_back(rand() % n_dijkstra);
+            weights.push_back(rand() % 100);
+        }
+    }
+    starts[n_dijkstra] = (int)targets.size();
+
+    std::cout << "prim: " << n_prim << " vertices (complete graph), "
+        << "dijkstra: " << n_dijkstra << " vertices, " << targets.size()
+        << " edges" << std::endl;
+    std::cout << std::setw(10) << "heap" << std::setw(12) << "prim (s)"
+        << std::setw(14) << "dijkstra (s)" << std::endl;
+
+    bench<DaryHeap<double, 2>, DaryHeap<int, 2> >("binary",
+        xs, ys, starts, targets, weights);
+    bench<DaryHeap<double, 4>, DaryHeap<int, 4> >("4-ary",
+        xs, ys, starts, targets, weights);
+    bench<DaryHeap<double, 8>, DaryHeap<int, 8> >("8-ary",
+        xs, ys, starts, targets, weights);
+    bench<PairingHeap<double>, PairingHeap<int> >("pairing",
+        xs, ys, starts, targets, weights);
+    bench<AlignedHeap<double, 4>, AlignedHeap<int, 8> >("aligned",
+        xs, ys, starts, targets, weights);
+
+    return 0;
+}
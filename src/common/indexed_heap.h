@@ -0,0 +1,499 @@
+/* Copyright 2016 Erik Perillo */
+
+/*
+Indexed min-priority queues of values 0..n_vals-1 ordered by keys.
+All of them share the same interface, so algorithms may be templated on
+the queue type:
+    heap_type(int n_vals)
+        empty queue.
+    heap_type(const std::vector<int>& vals, const std::vector<key_type>& keys)
+        queue with vals, where the key of val is keys[val].
+    bool empty() const
+    bool contains(int val) const
+    void push(int val, key_type key)
+        inserts val, which must not be in queue.
+    int pop()
+        removes and returns value of minimum key.
+    void update_key(int val, key_type key)
+        decreases key of val, which must be in queue.
+Keys are compared with operator<.
+*/
+
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+//position of values that are not in queue
+#define HEAP_NO_POS (-1)
+
+//kinds of heaps
+enum
+{
+    BINARY_HEAP=0,
+    QUATERNARY_HEAP,
+    OCTONARY_HEAP,
+    PAIRING_HEAP,
+    ALIGNED_HEAP
+};
+
+//Gets kind of heap from its name: binary, 4-ary, 8-ary, pairing or aligned.
+//Returns a negative number if name is invalid.
+inline int heap_kind(const std::string& name)
+{
+    const char* names[] = {"binary", "4-ary", "8-ary", "pairing", "aligned"};
+
+    for(int i=0; i<(int)(sizeof(names)/sizeof(names[0])); i++)
+        if(name == names[i])
+            return i;
+
+    return -1;
+}
+
+/*
+Class representing a d-ary heap.
+The heap holds values; keys are kept in a separate array indexed by value.
+Sifting moves a hole instead of swapping, so each level costs one write.
+*/
+template <class key_type, int arity>
+class DaryHeap
+{
+    public:
+    //constructors
+    DaryHeap(int n_vals):
+        keys(n_vals), positions(n_vals, HEAP_NO_POS)
+    {
+        this->vals.reserve(n_vals);
+    }
+    DaryHeap(const std::vector<int>& vals, const std::vector<key_type>& keys):
+        vals(vals), keys(keys), positions(keys.size(), HEAP_NO_POS)
+    {
+        for(unsigned i=0; i<this->vals.size(); i++)
+            this->positions[this->vals[i]] = i;
+        if(this->size() > 1)
+            for(int i=(this->size()-2)/arity; i>=0; i--)
+                this->sift_down(i, this->vals[i]);
+    }
+    //destructor
+    ~DaryHeap()
+    {;}
+
+    //True if heap is empty.
+    bool empty() const
+    {
+        return this->vals.empty();
+    }
+
+    //True if val is in heap.
+    bool contains(int val) const
+    {
+        return this->positions[val] != HEAP_NO_POS;
+    }
+
+    //Inserts val with key.
+    void push(int val, key_type key)
+    {
+        this->keys[val] = key;
+        this->vals.push_back(val);
+        this->sift_up(this->size()-1, val);
+    }
+
+    //Returns minimum element, removing it from heap.
+    int pop()
+    {
+        int ret = this->vals[0];
+        int last = this->vals.back();
+
+        this->vals.pop_back();
+        this->positions[ret] = HEAP_NO_POS;
+        if(!this->vals.empty())
+            this->sift_down(0, last);
+
+        return ret;
+    }
+
+    //Decreases key of val.
+    void update_key(int val, key_type key)
+    {
+        this->keys[val] = key;
+        this->sift_up(this->positions[val], val);
+    }
+
+    private:
+    //values, in heap order
+    std::vector<int> vals;
+    //keys of values
+    std::vector<key_type> keys;
+    //positions of values in vals vector
+    std::vector<int> positions;
+
+    //Number of elements in heap.
+    int size() const
+    {
+        return (int)this->vals.size();
+    }
+
+    //Puts val at position id of heap.
+    void place(int id, int val)
+    {
+        this->vals[id] = val;
+        this->positions[val] = id;
+    }
+
+    //Moves hole at id up until val fits in it.
+    void sift_up(int id, int val)
+    {
+        key_type key = this->keys[val];
+
+        while(id > 0)
+        {
+            int parent_id = (id - 1) / arity;
+            if(!(key < this->keys[this->vals[parent_id]]))
+                break;
+            this->place(id, this->vals[parent_id]);
+            id = parent_id;
+        }
+        this->place(id, val);
+    }
+
+    //Moves hole at id down until val fits in it.
+    void sift_down(int id, int val)
+    {
+        key_type key = this->keys[val];
+
+        while(true)
+        {
+            int first = arity*id + 1;
+            int last = std::min(first + arity, this->size());
+            int min_id = id;
+            key_type min_key = key;
+
+            for(int child_id=first; child_id<last; child_id++)
+                if(this->keys[this->vals[child_id]] < min_key)
+                {
+                    min_id = child_id;
+                    min_key = this->keys[this->vals[child_id]];
+                }
+
+            if(min_id == id)
+                break;
+            this->place(id, this->vals[min_id]);
+            id = min_id;
+        }
+        this->place(id, val);
+    }
+};
+
+/*
+Class representing a pairing heap.
+Nodes are the values themselves: children, siblings and previous nodes are
+kept in arrays indexed by value, so no allocation happens after construction.
+*/
+template <class key_type>
+class PairingHeap
+{
+    public:
+    //constructors
+    PairingHeap(int n_vals):
+        root(HEAP_NO_POS), keys(n_vals), children(n_vals, HEAP_NO_POS),
+        siblings(n_vals, HEAP_NO_POS), prevs(n_vals, HEAP_NO_POS),
+        in_heap(n_vals, false)
+    {;}
+    PairingHeap(const std::vector<int>& vals,
+        const std::vector<key_type>& keys):
+        root(HEAP_NO_POS), keys(keys), children(keys.size(), HEAP_NO_POS),
+        siblings(keys.size(), HEAP_NO_POS), prevs(keys.size(), HEAP_NO_POS),
+        in_heap(keys.size(), false)
+    {
+        for(unsigned i=0; i<vals.size(); i++)
+            this->push(vals[i], keys[vals[i]]);
+    }
+    //destructor
+    ~PairingHeap()
+    {;}
+
+    //True if heap is empty.
+    bool empty() const
+    {
+        return this->root == HEAP_NO_POS;
+    }
+
+    //True if val is in heap.
+    bool contains(int val) const
+    {
+        return this->in_heap[val];
+    }
+
+    //Inserts val with key.
+    void push(int val, key_type key)
+    {
+        this->keys[val] = key;
+        this->children[val] = HEAP_NO_POS;
+        this->siblings[val] = HEAP_NO_POS;
+        this->prevs[val] = HEAP_NO_POS;
+        this->in_heap[val] = true;
+        if(this->root == HEAP_NO_POS)
+            this->root = val;
+        else
+            this->root = this->meld(this->root, val);
+    }
+
+    //Returns minimum element, removing it from heap.
+    int pop()
+    {
+        int ret = this->root;
+
+        this->in_heap[ret] = false;
+        this->root = this->merge_pairs(this->children[ret]);
+        if(this->root != HEAP_NO_POS)
+            this->prevs[this->root] = HEAP_NO_POS;
+
+        return ret;
+    }
+
+    //Decreases key of val.
+    void update_key(int val, key_type key)
+    {
+        this->keys[val] = key;
+        if(val == this->root)
+            return;
+
+        //cutting val's subtree
+        int prev = this->prevs[val];
+        if(this->children[prev] == val)
+            this->children[prev] = this->siblings[val];
+        else
+            this->siblings[prev] = this->siblings[val];
+        if(this->siblings[val] != HEAP_NO_POS)
+            this->prevs[this->siblings[val]] = prev;
+        this->siblings[val] = HEAP_NO_POS;
+        this->prevs[val] = HEAP_NO_POS;
+
+        this->root = this->meld(this->root, val);
+    }
+
+    private:
+    //value at root
+    int root;
+    //keys of values
+    std::vector<key_type> keys;
+    //first child of value
+    std::vector<int> children;
+    //next sibling of value
+    std::vector<int> siblings;
+    //previous sibling of value, or parent if it is the first child
+    std::vector<int> prevs;
+    //true if value is in heap
+    std::vector<bool> in_heap;
+
+    //Melds trees rooted at a and b. Returns new root.
+    int meld(int a, int b)
+    {
+        if(this->keys[b] < this->keys[a])
+            std::swap(a, b);
+
+        //b becomes first child of a
+        this->siblings[b] = this->children[a];
+        if(this->children[a] != HEAP_NO_POS)
+            this->prevs[this->children[a]] = b;
+        this->prevs[b] = a;
+        this->children[a] = b;
+        this->siblings[a] = HEAP_NO_POS;
+
+        return a;
+    }
+
+    //Melds list of siblings starting at first in two passes. Returns root.
+    int merge_pairs(int first)
+    {
+        std::vector<int>& pairs = this->pairs_buffer;
+
+        pairs.clear();
+        while(first != HEAP_NO_POS)
+        {
+            int a = first;
+            int b = this->siblings[a];
+
+            if(b == HEAP_NO_POS)
+            {
+                pairs.push_back(a);
+                break;
+            }
+            first = this->siblings[b];
+            this->siblings[a] = HEAP_NO_POS;
+            this->siblings[b] = HEAP_NO_POS;
+            pairs.push_back(this->meld(a, b));
+        }
+
+        if(pairs.empty())
+            return HEAP_NO_POS;
+
+        int ret = pairs.back();
+        for(int i=(int)pairs.size()-2; i>=0; i--)
+            ret = this->meld(pairs[i], ret);
+
+        return ret;
+    }
+
+    //roots of first pass of merge_pairs
+    std::vector<int> pairs_buffer;
+};
+
+/*
+Class representing an implicit d-ary heap of (key, value) entries.
+Keys are stored inline with values, so comparisons touch only the heap
+array, and the array is aligned so that the children of a node start at a
+cache line boundary (all of them in one line when arity entries take 64
+bytes, as 4 double keys or 8 int keys). Sifting moves a hole.
+*/
+template <class key_type, int arity=4>
+class AlignedHeap
+{
+    public:
+    //constructors
+    AlignedHeap(int n_vals):
+        n_entries(0), positions(n_vals, HEAP_NO_POS)
+    {
+        this->allocate(n_vals);
+    }
+    AlignedHeap(const std::vector<int>& vals,
+        const std::vector<key_type>& keys):
+        n_entries((int)vals.size()), positions(keys.size(), HEAP_NO_POS)
+    {
+        this->allocate((int)keys.size());
+        for(int i=0; i<this->n_entries; i++)
+            this->place(i, Entry(keys[vals[i]], vals[i]));
+        if(this->n_entries > 1)
+            for(int i=(this->n_entries-2)/arity; i>=0; i--)
+                this->sift_down(i, this->entries[i]);
+    }
+    //destructor
+    ~AlignedHeap()
+    {
+        free(this->storage);
+    }
+
+    //True if heap is empty.
+    bool empty() const
+    {
+        return this->n_entries == 0;
+    }
+
+    //True if val is in heap.
+    bool contains(int val) const
+    {
+        return this->positions[val] != HEAP_NO_POS;
+    }
+
+    //Inserts val with key.
+    void push(int val, key_type key)
+    {
+        this->sift_up(this->n_entries++, Entry(key, val));
+    }
+
+    //Returns minimum element, removing it from heap.
+    int pop()
+    {
+        int ret = this->entries[0].val;
+
+        this->positions[ret] = HEAP_NO_POS;
+        if(--this->n_entries > 0)
+            this->sift_down(0, this->entries[this->n_entries]);
+
+        return ret;
+    }
+
+    //Decreases key of val.
+    void update_key(int val, key_type key)
+    {
+        this->sift_up(this->positions[val], Entry(key, val));
+    }
+
+    private:
+    //element of heap
+    struct Entry
+    {
+        Entry()
+        {;}
+        Entry(key_type key, int val): key(key), val(val)
+        {;}
+
+        key_type key;
+        int val;
+    };
+
+    //memory block holding entries
+    void* storage;
+    //entries, in heap order. entry i is at a position congruent to
+    //i + arity - 1, so children of each node (arity*i+1..) start aligned.
+    Entry* entries;
+    //number of entries in heap
+    int n_entries;
+    //positions of values in entries
+    std::vector<int> positions;
+
+    //Allocates space for n_vals entries.
+    void allocate(int n_vals)
+    {
+        if(posix_memalign(&this->storage, 64,
+            (n_vals + arity) * sizeof(Entry)) != 0)
+            throw std::bad_alloc();
+        this->entries = (Entry*)this->storage + (arity - 1);
+    }
+
+    //Puts entry at position id of heap.
+    void place(int id, const Entry& entry)
+    {
+        this->entries[id] = entry;
+        this->positions[entry.val] = id;
+    }
+
+    //Moves hole at id up until entry fits in it.
+    void sift_up(int id, Entry entry)
+    {
+        while(id > 0)
+        {
+            int parent_id = (id - 1) / arity;
+            if(!(entry.key < this->entries[parent_id].key))
+                break;
+            this->place(id, this->entries[parent_id]);
+            id = parent_id;
+        }
+        this->place(id, entry);
+    }
+
+    //Moves hole at id down until entry fits in it.
+    void sift_down(int id, Entry entry)
+    {
+        while(true)
+        {
+            int first = arity*id + 1;
+            int last = std::min(first + arity, this->n_entries);
+            int min_id = id;
+            key_type min_key = entry.key;
+
+            for(int child_id=first; child_id<last; child_id++)
+                if(this->entries[child_id].key < min_key)
+                {
+                    min_id = child_id;
+                    min_key = this->entries[child_id].key;
+                }
+
+            if(min_id == id)
+                break;
+            this->place(id, this->entries[min_id]);
+            id = min_id;
+        }
+        this->place(id, entry);
+    }
+
+    //heap is not copyable
+    AlignedHeap(const AlignedHeap&);
+    AlignedHeap& operator=(const AlignedHeap&);
+};
+
+#endif
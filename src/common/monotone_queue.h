@@ -0,0 +1,364 @@
+/* Copyright 2016 Erik Perillo */
+
+/*
+Indexed monotone min-priority queues of values 0..n_vals-1 ordered by
+non-negative integer keys.
+They have the interface of the queues of indexed_heap.h, with the extra
+requirement that keys pushed or updated are never smaller than the key of
+the last value popped, which holds for the keys of dijkstra when edge costs
+are non-negative. Values are kept in buckets by key, so no comparisons
+between keys are made.
+*/
+
+#ifndef MONOTONE_QUEUE_H
+#define MONOTONE_QUEUE_H
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include "indexed_heap.h"
+
+//kinds of monotone queues (following the kinds of heaps)
+enum
+{
+    RADIX_HEAP=ALIGNED_HEAP+1,
+    DIAL_QUEUE
+};
+
+//Gets kind of monotone queue from its name: radix or dial.
+//Returns a negative number if name is invalid.
+inline int monotone_queue_kind(const std::string& name)
+{
+    if(name == "radix")
+        return RADIX_HEAP;
+    if(name == "dial")
+        return DIAL_QUEUE;
+
+    return -1;
+}
+
+/*
+Class representing values distributed in buckets.
+Each bucket is an unordered array; values know their bucket and position
+in it, so insertion and removal take constant time.
+*/
+class Buckets
+{
+    public:
+    //constructor
+    Buckets(int n_vals, int n_buckets):
+        buckets(n_buckets), bucket_ids(n_vals, HEAP_NO_POS), positions(n_vals)
+    {;}
+    //destructor
+    ~Buckets()
+    {;}
+
+    //Number of buckets.
+    int n_buckets() const
+    {
+        return (int)this->buckets.size();
+    }
+
+    //Values in bucket.
+    const std::vector<int>& bucket(int bucket_id) const
+    {
+        return this->buckets[bucket_id];
+    }
+
+    //Gets bucket of val (HEAP_NO_POS if val is in none).
+    int bucket_of(int val) const
+    {
+        return this->bucket_ids[val];
+    }
+
+    //Inserts val in bucket.
+    void insert(int val, int bucket_id)
+    {
+        this->bucket_ids[val] = bucket_id;
+        this->positions[val] = (int)this->buckets[bucket_id].size();
+        this->buckets[bucket_id].push_back(val);
+    }
+
+    //Removes val from its bucket.
+    void remove(int val)
+    {
+        std::vector<int>& bucket = this->buckets[this->bucket_ids[val]];
+        int last = bucket.back();
+
+        bucket[this->positions[val]] = last;
+        this->positions[last] = this->positions[val];
+        bucket.pop_back();
+        this->bucket_ids[val] = HEAP_NO_POS;
+    }
+
+    //Removes and returns last value of bucket.
+    int pop_back(int bucket_id)
+    {
+        int val = this->buckets[bucket_id].back();
+
+        this->buckets[bucket_id].pop_back();
+        this->bucket_ids[val] = HEAP_NO_POS;
+
+        return val;
+    }
+
+    //Removes all values from bucket, returning them in vals.
+    void take(int bucket_id, std::vector<int>& vals)
+    {
+        vals.clear();
+        vals.swap(this->buckets[bucket_id]);
+        for(unsigned i=0; i<vals.size(); i++)
+            this->bucket_ids[vals[i]] = HEAP_NO_POS;
+    }
+
+    private:
+    //values of each bucket
+    std::vector<std::vector<int> > buckets;
+    //bucket and position in it of each value
+    std::vector<int> bucket_ids;
+    std::vector<int> positions;
+};
+
+/*
+Class representing a radix heap.
+Bucket 0 holds values with key equal to the last key popped, and bucket
+i > 0 the ones whose key first differs from it at bit i-1 (from the least
+significant), so a value only moves to lower buckets, at most once per bit
+of the keys.
+*/
+template <class key_type>
+class RadixHeap
+{
+    public:
+    //constructors
+    RadixHeap(int n_vals):
+        keys(n_vals), buckets(n_vals, N_BUCKETS), size(0), last(0)
+    {;}
+    RadixHeap(const std::vector<int>& vals, const std::vector<key_type>& keys):
+        keys(keys), buckets((int)keys.size(), N_BUCKETS), size(0), last(0)
+    {
+        for(unsigned i=0; i<vals.size(); i++)
+            this->push(vals[i], keys[vals[i]]);
+    }
+    //destructor
+    ~RadixHeap()
+    {;}
+
+    //True if heap is empty.
+    bool empty() const
+    {
+        return this->size == 0;
+    }
+
+    //True if val is in heap.
+    bool contains(int val) const
+    {
+        return this->buckets.bucket_of(val) != HEAP_NO_POS;
+    }
+
+    //Inserts val with key.
+    void push(int val, key_type key)
+    {
+        this->keys[val] = key;
+        this->buckets.insert(val, this->bucket_of(key));
+        this->size++;
+    }
+
+    //Returns minimum element, removing it from heap.
+    int pop()
+    {
+        if(this->buckets.bucket(0).empty())
+        {
+            //redistributing first non-empty bucket around its minimum
+            int bucket_id = 1;
+
+            while(this->buckets.bucket(bucket_id).empty())
+                bucket_id++;
+            this->buckets.take(bucket_id, this->moved);
+            this->last = this->keys[this->moved[0]];
+            for(unsigned i=1; i<this->moved.size(); i++)
+                if(this->keys[this->moved[i]] < this->last)
+                    this->last = this->keys[this->moved[i]];
+            for(unsigned i=0; i<this->moved.size(); i++)
+                this->buckets.insert(this->moved[i],
+                    this->bucket_of(this->keys[this->moved[i]]));
+        }
+        this->size--;
+
+        return this->buckets.pop_back(0);
+    }
+
+    //Decreases key of val.
+    void update_key(int val, key_type key)
+    {
+        this->buckets.remove(val);
+        this->keys[val] = key;
+        this->buckets.insert(val, this->bucket_of(key));
+    }
+
+    private:
+    //one bucket for the last key and one for each bit of keys
+    enum {N_BUCKETS = 8*sizeof(key_type) + 1};
+
+    //keys of values
+    std::vector<key_type> keys;
+    //values in heap
+    Buckets buckets;
+    //number of values in heap
+    int size;
+    //last key popped
+    key_type last;
+    //buffer of values of redistributed bucket
+    std::vector<int> moved;
+
+    //Gets bucket of key: position of most significant bit where it differs
+    //from last key popped, plus one.
+    int bucket_of(key_type key) const
+    {
+        uint64_t diff = (uint64_t)(key ^ this->last);
+
+        return diff == 0? 0: 64 - __builtin_clzll(diff);
+    }
+};
+
+/*
+Class representing a Dial queue: a circular array of n_buckets buckets,
+one per key in [last, last + n_buckets), where last is the last key
+popped. Keys further away, such as the infinite ones, wait in an overflow
+bucket and enter the array when it reaches them. With n_buckets greater
+than the largest edge cost, dijkstra keeps all finite keys in the array.
+*/
+template <class key_type>
+class DialQueue
+{
+    public:
+    //constructors
+    DialQueue(int n_vals, int n_buckets):
+        keys(n_vals), buckets(n_vals, n_buckets + 1),
+        ring_size(0), overflow_size(0), last(0), overflow_min(0)
+    {;}
+    DialQueue(const std::vector<int>& vals, const std::vector<key_type>& keys,
+        int n_buckets):
+        keys(keys), buckets((int)keys.size(), n_buckets + 1),
+        ring_size(0), overflow_size(0), last(0), overflow_min(0)
+    {
+        for(unsigned i=0; i<vals.size(); i++)
+            this->push(vals[i], keys[vals[i]]);
+    }
+    //destructor
+    ~DialQueue()
+    {;}
+
+    //True if queue is empty.
+    bool empty() const
+    {
+        return this->ring_size + this->overflow_size == 0;
+    }
+
+    //True if val is in queue.
+    bool contains(int val) const
+    {
+        return this->buckets.bucket_of(val) != HEAP_NO_POS;
+    }
+
+    //Inserts val with key.
+    void push(int val, key_type key)
+    {
+        this->keys[val] = key;
+        this->insert(val);
+    }
+
+    //Returns minimum element, removing it from queue.
+    int pop()
+    {
+        while(true)
+        {
+            //empty array jumps to overflow values, which enter it once
+            //reached
+            if(this->ring_size == 0)
+                this->last = this->overflow_min;
+            if(this->overflow_size > 0 && this->last >= this->overflow_min)
+            {
+                this->flush_overflow();
+                continue;
+            }
+
+            int bucket_id = (int)(this->last % this->n_ring_buckets());
+            if(!this->buckets.bucket(bucket_id).empty())
+            {
+                this->ring_size--;
+                return this->buckets.pop_back(bucket_id);
+            }
+            this->last++;
+        }
+    }
+
+    //Decreases key of val.
+    void update_key(int val, key_type key)
+    {
+        if(this->buckets.bucket_of(val) == this->overflow_id())
+            this->overflow_size--;
+        else
+            this->ring_size--;
+        this->buckets.remove(val);
+        this->keys[val] = key;
+        this->insert(val);
+    }
+
+    private:
+    //keys of values
+    std::vector<key_type> keys;
+    //buckets of circular array, followed by overflow bucket
+    Buckets buckets;
+    //number of values in array and in overflow bucket
+    int ring_size;
+    int overflow_size;
+    //key of current bucket of array (last key popped)
+    key_type last;
+    //lower bound of keys in overflow bucket
+    key_type overflow_min;
+    //buffer of values of overflow bucket
+    std::vector<int> moved;
+
+    //Number of buckets in circular array.
+    int n_ring_buckets() const
+    {
+        return this->buckets.n_buckets() - 1;
+    }
+
+    //Id of overflow bucket.
+    int overflow_id() const
+    {
+        return this->buckets.n_buckets() - 1;
+    }
+
+    //Inserts val in its bucket.
+    void insert(int val)
+    {
+        key_type key = this->keys[val];
+
+        if(key - this->last < (key_type)this->n_ring_buckets())
+        {
+            this->buckets.insert(val, (int)(key % this->n_ring_buckets()));
+            this->ring_size++;
+        }
+        else
+        {
+            if(this->overflow_size == 0 || key < this->overflow_min)
+                this->overflow_min = key;
+            this->buckets.insert(val, this->overflow_id());
+            this->overflow_size++;
+        }
+    }
+
+    //Moves values of overflow bucket with keys in reach to array.
+    void flush_overflow()
+    {
+        this->buckets.take(this->overflow_id(), this->moved);
+        this->overflow_size = 0;
+        for(unsigned i=0; i<this->moved.size(); i++)
+            this->insert(this->moved[i]);
+    }
+};
+
+#endif
@@ -0,0 +1,140 @@
+/* Copyright 2016 Erik Perillo */
+
+/*
+Pool of persistent threads running tasks split among them.
+*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <stdint.h>
+#include <pthread.h>
+
+/*
+Base class for work split among threads.
+run is called once on each thread, with its id in [0, n_threads).
+*/
+class ParallelTask
+{
+    public:
+    virtual ~ParallelTask()
+    {;}
+
+    virtual void run(int thread_id, int n_threads) = 0;
+};
+
+/*
+Class representing a pool of persistent threads.
+run executes a task on all threads (the calling one is thread 0) and
+returns when all of them are done. Between tasks, threads sleep on a
+barrier. Inside a task, threads may synchronize with barrier().
+*/
+class ThreadPool
+{
+    public:
+    //constructor
+    ThreadPool(int n_threads):
+        threads(n_threads), args(n_threads), task(NULL), stop(false)
+    {
+        pthread_barrier_init(&this->start_barrier, NULL, n_threads);
+        pthread_barrier_init(&this->end_barrier, NULL, n_threads);
+        pthread_barrier_init(&this->task_barrier, NULL, n_threads);
+
+        for(int i=1; i<n_threads; i++)
+        {
+            this->args[i].pool = this;
+            this->args[i].thread_id = i;
+            pthread_create(&this->threads[i], NULL, ThreadPool::worker,
+                &this->args[i]);
+        }
+    }
+    //destructor
+    ~ThreadPool()
+    {
+        this->stop = true;
+        pthread_barrier_wait(&this->start_barrier);
+        for(int i=1; i<this->n_threads(); i++)
+            pthread_join(this->threads[i], NULL);
+
+        pthread_barrier_destroy(&this->start_barrier);
+        pthread_barrier_destroy(&this->end_barrier);
+        pthread_barrier_destroy(&this->task_barrier);
+    }
+
+    //Returns number of threads in pool.
+    int n_threads() const
+    {
+        return (int)this->threads.size();
+    }
+
+    //Runs task on all threads, waiting for them to finish.
+    void run(ParallelTask& task)
+    {
+        this->task = &task;
+        pthread_barrier_wait(&this->start_barrier);
+        task.run(0, this->n_threads());
+        pthread_barrier_wait(&this->end_barrier);
+        this->task = NULL;
+    }
+
+    //Waits until all threads running current task reach this point.
+    //Returns true on exactly one of the threads.
+    bool barrier()
+    {
+        return pthread_barrier_wait(&this->task_barrier) ==
+            PTHREAD_BARRIER_SERIAL_THREAD;
+    }
+
+    private:
+    //arguments of worker threads
+    struct WorkerArgs
+    {
+        ThreadPool* pool;
+        int thread_id;
+    };
+
+    //threads (position 0 is unused: it is the calling thread)
+    std::vector<pthread_t> threads;
+    std::vector<WorkerArgs> args;
+    //current task
+    ParallelTask* task;
+    //true when threads must finish
+    bool stop;
+    //barriers for start and end of tasks, and for use inside tasks
+    pthread_barrier_t start_barrier;
+    pthread_barrier_t end_barrier;
+    pthread_barrier_t task_barrier;
+
+    //Loop of worker threads.
+    static void* worker(void* args)
+    {
+        ThreadPool* pool = ((WorkerArgs*)args)->pool;
+        int thread_id = ((WorkerArgs*)args)->thread_id;
+
+        while(true)
+        {
+            pthread_barrier_wait(&pool->start_barrier);
+            if(pool->stop)
+                break;
+            pool->task->run(thread_id, pool->n_threads());
+            pthread_barrier_wait(&pool->end_barrier);
+        }
+
+        return NULL;
+    }
+
+    //pool is not copyable
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+};
+
+//Range [begin, end) of [0, size) processed by thread thread_id.
+inline void thread_range(int size, int thread_id, int n_threads,
+    int* begin, int* end)
+{
+    *begin = (int)(((int64_t)size * thread_id) / n_threads);
+    *end = (int)(((int64_t)size * (thread_id + 1)) / n_threads);
+}
+
+#endif
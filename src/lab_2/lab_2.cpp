@@ -4,6 +4,8 @@
 #include <vector>
 #include <iostream>
 #include <string>
+#include <limits>
+#include <algorithm>
 
 //edge colors enumeration
 enum
@@ -119,8 +121,9 @@ class Edge
 	//constructors
 	Edge()
 	{;}
-	Edge(const Vertex<type>& u, const Vertex<type>& v, int color): 
-		u(u), v(v), color(color)
+	Edge(const Vertex<type>& u, const Vertex<type>& v, int color,
+		double weight=1.0): 
+		u(u), v(v), color(color), weight(weight)
 	{;}
 	//destructor
 	~Edge()
@@ -149,6 +152,10 @@ class Edge
 	{
 		return this->color;
 	}
+	double getWeight() const
+	{
+		return this->weight;
+	}
 	
 	private:
 	//first connection vertex
@@ -157,12 +164,14 @@ class Edge
 	Vertex<type> v;
 	//color of vertex
 	int color;
+	//weight (or multiplicity) of edge
+	double weight;
 	
 };
 
 //forward declaration
 template <class type>
-void fill_graph(Graph<type>& graph);
+void fill_graph(Graph<type>& graph, bool weighted=false);
 
 /*
 Class representing a graph using adjacency lists.
@@ -184,7 +193,7 @@ class Graph
 	{;}
 
 	//helper function to build graph
-	friend void fill_graph<type>(Graph<type>& graph);
+	friend void fill_graph<type>(Graph<type>& graph, bool weighted);
 
 	//Returns index of vertex in graph. 
 	//If it doesn't exist, returns a negative number.
@@ -215,7 +224,7 @@ class Graph
 	}
 
 	//Returns ith vertex in graph.
-	Vertex<type> operator[](int i) const
+	const Vertex<type>& operator[](int i) const
 	{
 		return this->vertices[i];
 	}
@@ -232,6 +241,12 @@ class Graph
 
 		return this->edges_colors[u_idx][v_idx];
 	}
+
+	//Gets the weight of edge (u, v).
+	double edge_weight(int u_idx, int v_idx) const
+	{
+		return this->edges_weights[u_idx][v_idx];
+	}
 	
 	//Prints all vertices with their adjacencies.
 	void print() const
@@ -263,6 +278,7 @@ class Graph
 	int num_edges;
 	std::vector<Vertex<type> > vertices;
 	std::vector<std::vector<int > > edges_colors;
+	std::vector<std::vector<double> > edges_weights;
 
 	protected:
 	//functions used to build graph
@@ -275,6 +291,8 @@ class Graph
 
 		this->vertices.push_back(vertex);
 		this->edges_colors.push_back(std::vector<int>(this->num_vertices, -1));
+		this->edges_weights.push_back(
+			std::vector<double>(this->num_vertices, 0.0));
 
 		return this->vertices.size() - 1;
 	}
@@ -289,26 +307,31 @@ class Graph
 
 		this->vertices[u_id].add(v_id);
 		this->edges_colors[u_id][v_id] = edge.getColor();
+		this->edges_weights[u_id][v_id] = edge.getWeight();
 	}
 };
 
 //Reads from stdin num_edges times, each time getting one edge and 
 //adding it to graph.
+//If weighted, each edge is followed by its weight, else it has weight 1.
 template <class type>
-void fill_graph(Graph<type>& graph)
+void fill_graph(Graph<type>& graph, bool weighted)
 {
 	type u_tp, v_tp;
 	int color;
+	double weight = 1.0;
 
 	for(int i=0; i<graph.n_edges(); i++)
 	{
 		std::cin >> u_tp;
 		std::cin >> v_tp;	
 		std::cin >> color;	
+		if(weighted)
+			std::cin >> weight;
 		Vertex<type> u(u_tp);
 		Vertex<type> v(v_tp);
 
-		graph.add_edge(Edge<type>(u, v, color));
+		graph.add_edge(Edge<type>(u, v, color, weight));
 	}
 }
 
@@ -385,93 +408,292 @@ DFSResults dfs(const Graph<type>& graph)
 	return DFSResults(start_times, end_times, parents, top_sort);
 }
 
+/*
+Semirings for the paths dynamic programming.
+Each one defines its value type, the neutral elements of 'plus' and 'times',
+the operations themselves, which edge weights it accepts and how an edge
+weight maps into a value.
+*/
+
+//(+, x): number of paths. Edge weights are multiplicities, so they must be
+//integers.
+struct CountSemiring
+{
+	typedef int value_type;
+
+	static value_type zero()
+	{
+		return 0;
+	}
+	static value_type one()
+	{
+		return 1;
+	}
+	static value_type plus(value_type a, value_type b)
+	{
+		return a + b;
+	}
+	static value_type times(value_type a, value_type b)
+	{
+		return a * b;
+	}
+	static bool accepts_weight(double weight)
+	{
+		return weight >= std::numeric_limits<int>::min() &&
+			weight <= std::numeric_limits<int>::max() &&
+			weight == (double)(int)weight;
+	}
+	static value_type from_weight(double weight)
+	{
+		return (int)weight;
+	}
+};
+
+//(min, +): length of shortest path. Unreachable is inf.
+struct ShortestPathSemiring
+{
+	typedef double value_type;
+
+	static value_type zero()
+	{
+		return std::numeric_limits<double>::infinity();
+	}
+	static value_type one()
+	{
+		return 0.0;
+	}
+	static value_type plus(value_type a, value_type b)
+	{
+		return std::min(a, b);
+	}
+	static value_type times(value_type a, value_type b)
+	{
+		return a + b;
+	}
+	static bool accepts_weight(double weight)
+	{
+		return true;
+	}
+	static value_type from_weight(double weight)
+	{
+		return weight;
+	}
+};
+
+//(max, +): length of longest path. Unreachable is -inf.
+struct LongestPathSemiring
+{
+	typedef double value_type;
+
+	static value_type zero()
+	{
+		return -std::numeric_limits<double>::infinity();
+	}
+	static value_type one()
+	{
+		return 0.0;
+	}
+	static value_type plus(value_type a, value_type b)
+	{
+		return std::max(a, b);
+	}
+	static value_type times(value_type a, value_type b)
+	{
+		return a + b;
+	}
+	static bool accepts_weight(double weight)
+	{
+		return true;
+	}
+	static value_type from_weight(double weight)
+	{
+		return weight;
+	}
+};
+
+//(+, x) over reals: probability of reaching end vertex.
+//Edge weights are the probabilities of taking each edge.
+struct ProbabilitySemiring
+{
+	typedef double value_type;
+
+	static value_type zero()
+	{
+		return 0.0;
+	}
+	static value_type one()
+	{
+		return 1.0;
+	}
+	static value_type plus(value_type a, value_type b)
+	{
+		return a + b;
+	}
+	static value_type times(value_type a, value_type b)
+	{
+		return a * b;
+	}
+	static bool accepts_weight(double weight)
+	{
+		return true;
+	}
+	static value_type from_weight(double weight)
+	{
+		return weight;
+	}
+};
+
+//Values of paths from a vertex to end vertex, by color of the first edge.
+//Colors are kept together so each vertex is a single contiguous block.
+template <class value_type>
+struct ColorPaths
+{
+	ColorPaths(const value_type& zero): green(zero), yellow(zero), red(zero)
+	{;}
+
+	value_type green;
+	value_type yellow;
+	value_type red;
+};
+
 //get_paths auxiliar function.
-template <class type>
+template <class semiring, class type>
 void _get_paths(const Graph<type>& graph, const DFSResults& dfs_res, int idx,
-	std::vector<int>& g_paths, std::vector<int>& y_paths, 
-	std::vector<int>& r_paths)
+	std::vector<ColorPaths<typename semiring::value_type> >& paths)
 {
+	typedef typename semiring::value_type value_type;
 	int u_idx;
 	int v_idx;
 
 	u_idx = dfs_res.top_sort[idx];
 
-	for(int i=0; i<graph[u_idx].n_connections(); i++)
+	const Vertex<type>& u = graph[u_idx];
+	ColorPaths<value_type>& u_paths = paths[u_idx];
+
+	for(int i=0; i<u.n_connections(); i++)
 	{
-		v_idx = graph[u_idx][i];
+		v_idx = u[i];
+
+		const ColorPaths<value_type>& v_paths = paths[v_idx];
+		value_type weight = 
+			semiring::from_weight(graph.edge_weight(u_idx, v_idx));
 
 		switch(graph.edge_color(u_idx, v_idx))
 		{
 			case GREEN:
-				g_paths[u_idx] += 
-					g_paths[v_idx] + y_paths[v_idx] + r_paths[v_idx];
+				u_paths.green = semiring::plus(u_paths.green, 
+					semiring::times(weight, semiring::plus(v_paths.green,
+						semiring::plus(v_paths.yellow, v_paths.red))));
 				break;
 			case YELLOW:
-				y_paths[u_idx] += y_paths[v_idx] + g_paths[v_idx];
+				u_paths.yellow = semiring::plus(u_paths.yellow, 
+					semiring::times(weight, 
+						semiring::plus(v_paths.yellow, v_paths.green)));
 				break;
 			case RED:
-				r_paths[u_idx] += g_paths[v_idx];
+				u_paths.red = semiring::plus(u_paths.red, 
+					semiring::times(weight, v_paths.green));
 				break;
 		}	
 	}
 }
 
-//Computes number of possible paths following the colors rule 
-//from start vertex to end vertex for each vertex in graph. 
-template <class type>
-std::vector<int> get_paths(const Graph<type> graph, const DFSResults& dfs_res,
-	int start_idx, int end_idx)
+//Computes value of paths following the colors rule 
+//from start vertex to end vertex for each vertex in graph, over semiring.
+//With CountSemiring, that is the number of possible paths.
+template <class semiring, class type>
+std::vector<typename semiring::value_type> get_paths(const Graph<type>& graph,
+	const DFSResults& dfs_res, int start_idx, int end_idx)
 {
-	//the ith element has the number of paths from the vertex of index
+	typedef typename semiring::value_type value_type;
+	//the ith element has the value of paths from the vertex of index
 	//i in graph to the end vertex
-	std::vector<int> g_paths(dfs_res.top_sort.size(), 0);
-	std::vector<int> y_paths(dfs_res.top_sort.size(), 0);
-	std::vector<int> r_paths(dfs_res.top_sort.size(), 0);
-	std::vector<int> paths(dfs_res.top_sort.size(), 0);
+	std::vector<ColorPaths<value_type> > color_paths(dfs_res.top_sort.size(),
+		ColorPaths<value_type>(semiring::zero()));
+	std::vector<value_type> paths(dfs_res.top_sort.size(), semiring::zero());
 
-	g_paths[end_idx] = 1;
+	color_paths[end_idx].green = semiring::one();
 
 	for(int i=(int)dfs_res.top_sort.size()-1; i>=0; i--)
-		_get_paths(graph, dfs_res, i, g_paths, y_paths, r_paths);
+		_get_paths<semiring>(graph, dfs_res, i, color_paths);
 
 	for(unsigned i=0; i<paths.size(); i++)
-		paths[i] = g_paths[i] + y_paths[i] + r_paths[i];
+		paths[i] = semiring::plus(color_paths[i].green, 
+			semiring::plus(color_paths[i].yellow, color_paths[i].red));
 
 	return paths;
 }
 
-//Gets number of possible paths from start vertex to end vertex
-//following the colors rule.
-template <class type>
-int num_paths(const Graph<type> graph, const Vertex<type>& start_vtx,
-	const Vertex<type>& end_vtx)
+//Gets value of paths from start vertex to end vertex
+//following the colors rule, over semiring.
+template <class semiring, class type>
+typename semiring::value_type num_paths(const Graph<type>& graph,
+	const Vertex<type>& start_vtx, const Vertex<type>& end_vtx)
 {
 	int start_vtx_idx, end_vtx_idx;
-	std::vector<int> paths;
+	std::vector<typename semiring::value_type> paths;
 	DFSResults dfs_res;
 
 	if(start_vtx == end_vtx)
-		return 1;
+		return semiring::one();
 
 	dfs_res = dfs(graph);
 
 	start_vtx_idx = graph.index(start_vtx);
 	end_vtx_idx = graph.index(end_vtx);
-	if(start_vtx_idx < 0)
-		return 0;
+	if(start_vtx_idx < 0 || end_vtx_idx < 0)
+		return semiring::zero();
 
-	paths = get_paths(graph, dfs_res, start_vtx_idx, end_vtx_idx);
+	paths = get_paths<semiring>(graph, dfs_res, start_vtx_idx, end_vtx_idx);
 
 	return paths[start_vtx_idx];
 }
 
+//Prints value of paths from start vertex to end vertex over semiring.
+//Returns false (printing nothing) if semiring does not accept the weight of
+//some edge.
+template <class semiring>
+bool print_paths(const Graph<int>& graph, int start_vtx, int end_vtx)
+{
+	for(int u_idx=0; u_idx<graph.n_vertices(); u_idx++)
+		for(int v_idx=0; v_idx<graph.n_vertices(); v_idx++)
+			if(graph.edge_color(u_idx, v_idx) >= 0 &&
+				!semiring::accepts_weight(graph.edge_weight(u_idx, v_idx)))
+				return false;
+
+	std::cout << num_paths<semiring>(graph, Vertex<int>(start_vtx), 
+		Vertex<int>(end_vtx)) << std::endl;
+
+	return true;
+}
+
 using namespace std;
 
-int main()
+//usage: lab_2 [--weighted] [--semiring=count|shortest|longest|probability]
+//--weighted: each edge in input is followed by its weight.
+//--semiring: what to compute over paths. default is count, where weights
+//are multiplicities and must be integers.
+int main(int argc, char** argv)
 {
 	int num_vtxs, num_edges, start_vtx, end_vtx;
-	int ret;
-	DFSResults dfs_res;
+	bool weighted = false;
+	string semiring = "count";
+	bool valid_weights;
+
+	for(int i=1; i<argc; i++)
+	{
+		string arg = argv[i];
+
+		if(arg == "--weighted")
+			weighted = true;
+		else if(arg.find("--semiring=") == 0)
+			semiring = arg.substr(string("--semiring=").size());
+		else
+		{
+			cerr << "invalid argument '" << arg << "'" << endl;
+			return 1;
+		}
+	}
 
 	//getting initial graph parameters
 	cin >> num_vtxs;
@@ -481,12 +703,32 @@ int main()
 
 	//building graph
 	Graph<int> graph(num_vtxs, num_edges);
-	fill_graph<int>(graph);
-
-	//getting number of paths
-	ret = num_paths(graph, Vertex<int>(start_vtx), Vertex<int>(end_vtx));
+	fill_graph<int>(graph, weighted);
+
+	//getting value of paths
+	if(semiring == "count")
+		valid_weights = print_paths<CountSemiring>(graph, start_vtx, end_vtx);
+	else if(semiring == "shortest")
+		valid_weights = print_paths<ShortestPathSemiring>(graph, start_vtx,
+			end_vtx);
+	else if(semiring == "longest")
+		valid_weights = print_paths<LongestPathSemiring>(graph, start_vtx,
+			end_vtx);
+	else if(semiring == "probability")
+		valid_weights = print_paths<ProbabilitySemiring>(graph, start_vtx,
+			end_vtx);
+	else
+	{
+		cerr << "invalid semiring '" << semiring << "'" << endl;
+		return 1;
+	}
 
-	cout << ret << endl;
+	if(!valid_weights)
+	{
+		cerr << "invalid edge weight for semiring '" << semiring << "'"
+			<< endl;
+		return 1;
+	}
 
 	return 0;
 }
@@ -0,0 +1 @@
+14.5
@@ -0,0 +1 @@
+invalid edge weight for semiring 'count'
@@ -4,14 +4,28 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <deque>
+#include <map>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include "indexed_heap.h"
+#include "thread_pool.h"
 
 //symbol for 'no parent'
 #define NONE (-1)
-//infinite graph weight symbol
-#define INF (-1)
-
-//true if edge graph weight a is bigger than b
-#define cost_greater(a, b) ((b == INF)?false:((a == INF)?true:(a > b)))
 
 //rounds float/double to nearest integer
 #define round(x) ((int)floor(x + 0.5))
@@ -21,160 +35,181 @@
 //euclidean distance between two points
 #define distance(x1, y1, x2, y2) (sqrt(sqr(x1 - x2) + sqr(y1 - y2)))
 
-//heap macros
-#define heap_parent(i) ((i+1)/2-1)
-#define heap_left(i) (2*(i+1)-1)
-#define heap_right(i) (2*(i+1))
+//minimum spanning tree engines
+enum
+{
+    //prim with binary heap
+    HEAP_PRIM=0,
+    //array-based prim, for dense graphs
+    DENSE_PRIM,
+    //kruskal over delaunay triangulation
+    DELAUNAY,
+    //boruvka over k-d tree
+    BORUVKA,
+    //array-based prim with steps split among threads
+    PARALLEL_PRIM,
+    //insertion of points one at a time with link-cut tree
+    INCREMENTAL,
+    //boruvka over uniform grid
+    GRID_BORUVKA
+};
 
-/*
-Class representing a fully-connected graph.
-*/
-class FullyConnectedGraph
+//precisions of coordinates and costs of dense engine
+enum
 {
-    public:
-    //constructors
-    FullyConnectedGraph()
-    {;}
-    FullyConnectedGraph(int num_vertices):
-        vertices(std::vector<std::vector<double> >
-            (num_vertices, std::vector<double>(num_vertices, 0.0)))
-    {;}
-    //destructor
-    ~FullyConnectedGraph()
-    {;}
+    DOUBLE_PRECISION=0,
+    FLOAT_PRECISION,
+    //32-bit fixed-point coordinates
+    FIXED_PRECISION
+};
 
-    //Returns number of vertices in graph.
-    int n_vertices() const
-    {
-        return (int)this->vertices.size();
-    }
+//forward declarations
+class ThreadPool;
+class PointFile;
 
-    //Adds edge to graph. Assumes both vertices are already in graph.
-    void set_edge_cost(int u_id, int v_id, double cost)
-    {
-        this->vertices[u_id][v_id] = cost;
-    }
-    double get_edge_cost(int u_id, int v_id) const
-    {
-        return this->vertices[u_id][v_id];
-    }
+//Struct with options of how to solve problem.
+struct Options
+{
+    Options():
+        engine(DENSE_PRIM),
+        n_threads(1),
+        pool(NULL),
+        batch(false),
+        heap(BINARY_HEAP),
+        incremental(false),
+        tile_size(1 << 20),
+        tmp_dir("/tmp"),
+        precision(DOUBLE_PRECISION),
+        verify(false),
+        points(NULL)
+    {;}
+    ~Options()
+    {;}
 
-    private:
-    //list of vertices
-    std::vector<std::vector<double> > vertices;
+    //minimum spanning tree engine
+    int engine;
+    //number of threads for parallel engines
+    int n_threads;
+    //pool of n_threads threads shared by parallel engines
+    ThreadPool* pool;
+    //true if each case has a list of thresholds
+    bool batch;
+    //kind of priority queue of heap engine
+    int heap;
+    //true if costs are printed after each point insertion
+    bool incremental;
+    //expected number of points per tile of external mode
+    int tile_size;
+    //directory of temporary files of external mode
+    std::string tmp_dir;
+    //precision of dense engine
+    int precision;
+    //true if results are checked against the double precision ones
+    bool verify;
+    //binary point file from which cases are read (stdin if NULL)
+    PointFile* points;
 };
 
-//Swaps values of x and y.
-void swap(int* x, int* y)
-{
-    int aux = *x;
-    *x = *y;
-    *y = aux;
-}
-
 /*
-Class representing min-heap, to be sorted by keys.
+Class representing a complete graph over points in the plane.
+Only the coordinates are stored (one array per axis): the cost of edge (u, v)
+is the euclidean distance between u and v, computed on demand.
+Coordinates are either owned by the graph or arrays viewed by it (such as
+the ones of a mapped binary point file), which must outlive it.
 */
-class MinHeapByKey
+class EuclideanGraph
 {
     public:
-    //constructor
-    MinHeapByKey(const std::vector<int>& vals, std::vector<double>& keys):
-        vals(vals), keys(keys), positions(std::vector<int>(keys.size(), 0))
+    //constructors
+    EuclideanGraph():
+        x_data(NULL), y_data(NULL), size(0)
+    {;}
+    EuclideanGraph(int num_vertices):
+        x_data(NULL), y_data(NULL), size(0)
     {
-        this->build_heap();
-        for(unsigned i=0; i<vals.size(); i++)
-            this->positions[vals[i]] = i;
+        this->xs.reserve(num_vertices);
+        this->ys.reserve(num_vertices);
     }
-    //destructor
-    ~MinHeapByKey()
+    //Graph viewing num_vertices coordinates in arrays xs and ys.
+    EuclideanGraph(const double* xs, const double* ys, int num_vertices):
+        x_data(xs), y_data(ys), size(num_vertices)
     {;}
-
-    //True if heap is empty.
-    bool empty()
+    EuclideanGraph(const EuclideanGraph& graph):
+        xs(graph.xs), ys(graph.ys), x_data(graph.x_data),
+        y_data(graph.y_data), size(graph.size)
     {
-        return this->vals_size() == 0;
+        this->own_data();
     }
+    //destructor
+    ~EuclideanGraph()
+    {;}
 
-    //Returns minimum element, removing it from heap and updating it.
-    int pop()
+    EuclideanGraph& operator=(const EuclideanGraph& graph)
     {
-        int ret;
-
-        ret = this->vals[0];
-        this->swap(0, this->vals_size()-1);
-        this->vals.pop_back();
-        this->heapify(0);
+        this->xs = graph.xs;
+        this->ys = graph.ys;
+        this->x_data = graph.x_data;
+        this->y_data = graph.y_data;
+        this->size = graph.size;
+        this->own_data();
 
-        return ret;
+        return *this;
     }
 
-    //Updates pair key, val and updates heap.
-    void update_key(int val, double key_val)
+    //Returns number of vertices in graph.
+    int n_vertices() const
     {
-        this->keys[val] = key_val;
-        int id = this->positions[val];
-        while(id >= 0 && this->compare(id, heap_parent(id)))
-        {
-            this->swap(id, heap_parent(id));
-            id = heap_parent(id);
-        }
+        return this->size;
     }
 
-    private:
-    //values
-    std::vector<int> vals;
-    //keys of values
-    std::vector<double> keys;
-    //positions of values in vals vector
-    std::vector<int> positions;
-
-    //Number of elements in heap.
-    int vals_size()
+    //Adds vertex at point (x, y) to graph. Returns its id.
+    //Graph must own its coordinates.
+    int add_vertex(double x, double y)
     {
-        return (int)this->vals.size();
+        this->xs.push_back(x);
+        this->ys.push_back(y);
+        this->size++;
+        this->own_data();
+
+        return this->n_vertices() - 1;
     }
 
-    //True if key[val[id_1]] < key[val[id_2]].
-    bool compare(int id_1, int id_2)
+    //Gets cost of edge (u, v).
+    double get_edge_cost(int u_id, int v_id) const
     {
-        return cost_greater(this->keys[this->vals[id_2]],
-                this->keys[this->vals[id_1]]);
+        return distance(this->x_data[u_id], this->y_data[u_id],
+            this->x_data[v_id], this->y_data[v_id]);
     }
 
-    //Swaps val[id_2] with val[id_1], updating its positions.
-    void swap(int id_1, int id_2)
+    //Getters for coordinates of vertex u.
+    double get_x(int u_id) const
     {
-        this->positions[this->vals[id_1]] = id_2;
-        this->positions[this->vals[id_2]] = id_1;
-        ::swap(&this->vals[id_1], &this->vals[id_2]);
+        return this->x_data[u_id];
     }
-
-    //'floats down' value[id] in heap in order to put it at the right place.
-    void heapify(int id)
+    double get_y(int u_id) const
     {
-        int left_id = heap_left(id);
-        int right_id = heap_right(id);
-        int min_id = id;
+        return this->y_data[u_id];
+    }
 
-        if(left_id < this->vals_size() && this->compare(left_id, min_id))
-            min_id = left_id;
-        if(right_id < this->vals_size() && this->compare(right_id, min_id))
-            min_id = right_id;
+    private:
+    //x coordinates of vertices, if owned
+    std::vector<double> xs;
+    //y coordinates of vertices, if owned
+    std::vector<double> ys;
+    //coordinates of vertices
+    const double* x_data;
+    const double* y_data;
+    int size;
 
-        if(min_id != id)
+    //Points coordinates to owned ones, if any.
+    void own_data()
+    {
+        if(!this->xs.empty())
         {
-            this->swap(min_id, id);
-            this->heapify(min_id);
+            this->x_data = &this->xs[0];
+            this->y_data = &this->ys[0];
         }
     }
-
-    //Makes heap.
-    void build_heap()
-    {
-        for(int i=this->vals_size()/2; i>=0; i--)
-            this->heapify(i);
-    }
 };
 
 //Returns a list of vertex indexes that are still in priority queue.
@@ -188,38 +223,42 @@ std::vector<int> seq(int start, int end)
     return vec;
 }
 
-//Gets minimum spanning tree of graph, rooted in vertex vtx.
+//Gets minimum spanning tree of graph, rooted in vertex vtx, via prim
+//with priority queue of type heap_type.
 //Returns pi, the parents list.
-std::vector<int> min_spanning_tree(const FullyConnectedGraph& graph, int vtx_id)
+template <class heap_type>
+std::vector<int> min_spanning_tree(const EuclideanGraph& graph, int vtx_id)
 {
     //the ith element has the father of the ith vertex in graph in the mst
     //(minimum spanning tree).
     std::vector<int> pi(graph.n_vertices(), NONE);
     //the ith element has the current smallest distance from ith vertex
     //to vertexes in the mst.
-    std::vector<double> min_costs(graph.n_vertices(), INF);
+    std::vector<double> min_costs(graph.n_vertices(),
+        std::numeric_limits<double>::infinity());
     //setting root to have cost zero
     min_costs[vtx_id] = 0.0;
-    //the ith element tells if the ith vertex in graph is in the priority queue.
-    std::vector<bool> in_queue(graph.n_vertices(), true);
     //simply a vector of indexes of vertexes.
     std::vector<int> indexes = seq(0, graph.n_vertices()-1);
     //priority queue
-    MinHeapByKey queue(indexes, min_costs);
+    heap_type queue(indexes, min_costs);
 
     while(!queue.empty())
     {
         //getting element with minimum weight to mst.
         int u_id = queue.pop();
-        in_queue[u_id] = false;
 
         //updating key values
         for(int j=0; j<graph.n_vertices(); j++)
         {
             int v_id = j;
+
+            if(!queue.contains(v_id))
+                continue;
+
             double cost = graph.get_edge_cost(u_id, v_id);
 
-            if(in_queue[v_id] && cost_greater(min_costs[v_id], cost))
+            if(cost < min_costs[v_id])
             {
                 pi[v_id] = u_id;
                 min_costs[v_id] = cost;
@@ -231,93 +270,3995 @@ std::vector<int> min_spanning_tree(const FullyConnectedGraph& graph, int vtx_id)
     return pi;
 }
 
-//Reads from stdin coordinates values and builds graph.
-FullyConnectedGraph fill_graph(int n_lines)
+//Gets bounding box of points of graph. Returns false if graph is empty.
+bool bounding_box(const EuclideanGraph& graph, double& lo_x, double& hi_x,
+    double& lo_y, double& hi_y)
 {
-    FullyConnectedGraph graph(n_lines);
-    std::vector<double> xs;
-    std::vector<double> ys;
-    double x, y;
+    if(graph.n_vertices() == 0)
+        return false;
 
-    //reading coordinates
-    for(int i=0; i<n_lines; i++)
+    lo_x = hi_x = graph.get_x(0);
+    lo_y = hi_y = graph.get_y(0);
+    for(int i=1; i<graph.n_vertices(); i++)
     {
-        std::cin >> x;
-        std::cin >> y;
-        xs.push_back(x);
-        ys.push_back(y);
+        lo_x = std::min(lo_x, graph.get_x(i));
+        hi_x = std::max(hi_x, graph.get_x(i));
+        lo_y = std::min(lo_y, graph.get_y(i));
+        hi_y = std::max(hi_y, graph.get_y(i));
     }
 
-    //making edges with weights as distances
-    for(int i=0; i<n_lines; i++)
-        for(int j=0; j<n_lines; j++)
+    return true;
+}
+
+/*
+Precision policies of array-based Prim.
+Each one gives the types of coordinates, of squared costs and of parents
+(as wide as costs, so they can be blended in the same vector lanes), maps
+points of graph to coordinates and gets squared costs between them.
+Costs are only compared, so the tree found may differ from the exact one
+only among (nearly) tied edges; quantities of cable are then computed in
+double precision from the graph.
+*/
+//Double coordinates and costs.
+struct DoublePrecision
+{
+    typedef double coord_type;
+    typedef double cost_type;
+    typedef int64_t parent_type;
+
+    DoublePrecision(const EuclideanGraph& graph)
+    {;}
+
+    coord_type get_x(double x) const
+    {
+        return x;
+    }
+    coord_type get_y(double y) const
+    {
+        return y;
+    }
+
+    static cost_type sqr_dist(coord_type x1, coord_type y1,
+        coord_type x2, coord_type y2)
+    {
+        return sqr(x1 - x2) + sqr(y1 - y2);
+    }
+};
+
+//Float coordinates, relative to center of points, and float costs.
+struct FloatPrecision
+{
+    typedef float coord_type;
+    typedef float cost_type;
+    typedef int32_t parent_type;
+
+    FloatPrecision(const EuclideanGraph& graph):
+        center_x(0.0), center_y(0.0)
+    {
+        double lo_x, hi_x, lo_y, hi_y;
+
+        if(bounding_box(graph, lo_x, hi_x, lo_y, hi_y))
         {
-            double dist = distance(xs[i], ys[i], xs[j], ys[j]);
-            graph.set_edge_cost(i, j, dist);
+            this->center_x = (lo_x + hi_x)/2;
+            this->center_y = (lo_y + hi_y)/2;
         }
+    }
 
-    return graph;
+    coord_type get_x(double x) const
+    {
+        return (float)(x - this->center_x);
+    }
+    coord_type get_y(double y) const
+    {
+        return (float)(y - this->center_y);
+    }
+
+    static cost_type sqr_dist(coord_type x1, coord_type y1,
+        coord_type x2, coord_type y2)
+    {
+        return sqr(x1 - x2) + sqr(y1 - y2);
+    }
+
+    double center_x;
+    double center_y;
+};
+
+//32-bit fixed-point coordinates over bounding box of points (differences
+//are exact), and float costs.
+struct FixedPrecision
+{
+    typedef int32_t coord_type;
+    typedef float cost_type;
+    typedef int32_t parent_type;
+
+    FixedPrecision(const EuclideanGraph& graph):
+        lo_x(0.0), lo_y(0.0), scale(1.0)
+    {
+        double hi_x, hi_y;
+
+        //coordinates go from 0 to 2^30, so differences fit in 31 bits
+        if(bounding_box(graph, this->lo_x, hi_x, this->lo_y, hi_y) &&
+            std::max(hi_x - this->lo_x, hi_y - this->lo_y) > 0)
+            this->scale = (1 << 30) /
+                std::max(hi_x - this->lo_x, hi_y - this->lo_y);
+    }
+
+    coord_type get_x(double x) const
+    {
+        return (int32_t)floor((x - this->lo_x)*this->scale + 0.5);
+    }
+    coord_type get_y(double y) const
+    {
+        return (int32_t)floor((y - this->lo_y)*this->scale + 0.5);
+    }
+
+    static cost_type sqr_dist(coord_type x1, coord_type y1,
+        coord_type x2, coord_type y2)
+    {
+        return sqr((float)(x1 - x2)) + sqr((float)(y1 - y2));
+    }
+
+    double lo_x;
+    double lo_y;
+    double scale;
+};
+
+/*
+Working arrays of array-based Prim, in given precision.
+Vertices not yet in the tree are kept packed in the first 'size' positions,
+so each step is a single linear pass over contiguous memory.
+*/
+template <class precision>
+struct DensePrimState
+{
+    typedef typename precision::coord_type coord_type;
+    typedef typename precision::cost_type cost_type;
+    typedef typename precision::parent_type parent_type;
+
+    DensePrimState(const EuclideanGraph& graph):
+        size(graph.n_vertices()),
+        xs(graph.n_vertices()), ys(graph.n_vertices()),
+        costs(graph.n_vertices(), std::numeric_limits<cost_type>::infinity()),
+        parents(graph.n_vertices(), NONE), ids(graph.n_vertices())
+    {
+        precision policy(graph);
+
+        for(int i=0; i<graph.n_vertices(); i++)
+        {
+            this->xs[i] = policy.get_x(graph.get_x(i));
+            this->ys[i] = policy.get_y(graph.get_y(i));
+            this->ids[i] = i;
+        }
+    }
+    ~DensePrimState()
+    {;}
+
+    //Moves element at position k out of packed range.
+    void remove(int k)
+    {
+        int last = --this->size;
+
+        std::swap(this->xs[k], this->xs[last]);
+        std::swap(this->ys[k], this->ys[last]);
+        std::swap(this->costs[k], this->costs[last]);
+        std::swap(this->parents[k], this->parents[last]);
+        std::swap(this->ids[k], this->ids[last]);
+    }
+
+    //number of vertices not yet in the tree
+    int size;
+    //coordinates of vertices
+    std::vector<coord_type> xs;
+    std::vector<coord_type> ys;
+    //squared cost from vertex to the tree
+    std::vector<cost_type> costs;
+    //parent in tree of vertex
+    std::vector<parent_type> parents;
+    //original id of vertex
+    std::vector<int> ids;
+};
+
+//Relaxes costs of packed positions [k, end) against vertex u at (ux, uy)
+//one at a time, updating minimum cost found so far and its position.
+template <class precision>
+void dense_prim_relax_scalar(DensePrimState<precision>& state, int k, int end,
+    int u_id, typename precision::coord_type ux,
+    typename precision::coord_type uy,
+    typename precision::cost_type& min_cost, int& min_k)
+{
+    for(; k<end; k++)
+    {
+        typename precision::cost_type dist =
+            precision::sqr_dist(state.xs[k], state.ys[k], ux, uy);
+
+        if(dist < state.costs[k])
+        {
+            state.costs[k] = dist;
+            state.parents[k] = u_id;
+        }
+        if(state.costs[k] < min_cost)
+        {
+            min_cost = state.costs[k];
+            min_k = k;
+        }
+    }
 }
 
-//Gets quantity of normal and fiber cable to be used from minimum spanning tree.
-void get_dists(const FullyConnectedGraph& graph, const std::vector<int>& pi,
-        double fiber_thresh, double* normal_cable, double* fiber_cable)
+//Relaxes costs of packed positions [begin, end) against vertex u at (ux, uy)
+//and returns position of the one with minimum cost among them.
+//Returns NONE if range is empty.
+int dense_prim_relax(DensePrimState<DoublePrecision>& state, int begin,
+    int end, int u_id, double ux, double uy)
 {
-    *normal_cable = 0.0;
-    *fiber_cable = 0.0;
+    double min_cost = std::numeric_limits<double>::infinity();
+    int min_k = NONE;
+    int k = begin;
 
-    for(int i=0; i<(int)pi.size(); i++)
+#if defined(__AVX2__) || defined(__AVX512F__)
+    double* xs = &state.xs[0];
+    double* ys = &state.ys[0];
+    double* costs = &state.costs[0];
+    int64_t* parents = &state.parents[0];
+#endif
+
+#if defined(__AVX512F__)
+    __m512d vux = _mm512_set1_pd(ux);
+    __m512d vuy = _mm512_set1_pd(uy);
+    __m512i vu = _mm512_set1_epi64(u_id);
+    __m512d vmin = _mm512_set1_pd(min_cost);
+    __m512i vmin_k = _mm512_set1_epi64(NONE);
+    __m512i vk = _mm512_setr_epi64(k, k+1, k+2, k+3, k+4, k+5, k+6, k+7);
+    __m512i vstep = _mm512_set1_epi64(8);
+
+    for(; k+8<=end; k+=8)
     {
-        if(pi[i] == NONE)
-            continue;
+        __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(xs + k), vux);
+        __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(ys + k), vuy);
+        __m512d dist = _mm512_fmadd_pd(dx, dx, _mm512_mul_pd(dy, dy));
+        __m512d cost = _mm512_loadu_pd(costs + k);
+        __mmask8 less = _mm512_cmp_pd_mask(dist, cost, _CMP_LT_OQ);
 
-        double cost = graph.get_edge_cost(pi[i], i);
+        cost = _mm512_mask_blend_pd(less, cost, dist);
+        _mm512_storeu_pd(costs + k, cost);
+        _mm512_mask_storeu_epi64(parents + k, less, vu);
 
-        if(cost > fiber_thresh)
-            (*fiber_cable) += cost;
-        else
-            (*normal_cable) += cost;
+        __mmask8 is_min = _mm512_cmp_pd_mask(cost, vmin, _CMP_LT_OQ);
+        vmin = _mm512_mask_blend_pd(is_min, vmin, cost);
+        vmin_k = _mm512_mask_blend_epi64(is_min, vmin_k, vk);
+        vk = _mm512_add_epi64(vk, vstep);
+    }
+
+    double lane_min[8];
+    int64_t lane_min_k[8];
+    _mm512_storeu_pd(lane_min, vmin);
+    _mm512_storeu_si512(lane_min_k, vmin_k);
+    for(int i=0; i<8; i++)
+        if(lane_min[i] < min_cost)
+        {
+            min_cost = lane_min[i];
+            min_k = (int)lane_min_k[i];
+        }
+#elif defined(__AVX2__)
+    __m256d vux = _mm256_set1_pd(ux);
+    __m256d vuy = _mm256_set1_pd(uy);
+    __m256d vu = _mm256_castsi256_pd(_mm256_set1_epi64x(u_id));
+    __m256d vmin = _mm256_set1_pd(min_cost);
+    __m256d vmin_k = _mm256_castsi256_pd(_mm256_set1_epi64x(NONE));
+    __m256i vk = _mm256_setr_epi64x(k, k+1, k+2, k+3);
+    __m256i vstep = _mm256_set1_epi64x(4);
+
+    for(; k+4<=end; k+=4)
+    {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + k), vux);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + k), vuy);
+        __m256d dist = _mm256_add_pd(_mm256_mul_pd(dx, dx),
+            _mm256_mul_pd(dy, dy));
+        __m256d cost = _mm256_loadu_pd(costs + k);
+        __m256d less = _mm256_cmp_pd(dist, cost, _CMP_LT_OQ);
+        __m256d parent = _mm256_loadu_pd((double*)(parents + k));
+
+        cost = _mm256_blendv_pd(cost, dist, less);
+        _mm256_storeu_pd(costs + k, cost);
+        _mm256_storeu_pd((double*)(parents + k),
+            _mm256_blendv_pd(parent, vu, less));
+
+        __m256d is_min = _mm256_cmp_pd(cost, vmin, _CMP_LT_OQ);
+        vmin = _mm256_blendv_pd(vmin, cost, is_min);
+        vmin_k = _mm256_blendv_pd(vmin_k, _mm256_castsi256_pd(vk), is_min);
+        vk = _mm256_add_epi64(vk, vstep);
     }
+
+    double lane_min[4];
+    int64_t lane_min_k[4];
+    _mm256_storeu_pd(lane_min, vmin);
+    _mm256_storeu_pd((double*)lane_min_k, vmin_k);
+    for(int i=0; i<4; i++)
+        if(lane_min[i] < min_cost)
+        {
+            min_cost = lane_min[i];
+            min_k = (int)lane_min_k[i];
+        }
+#endif
+
+    //scalar loop (also remainder of vectorized loops)
+    dense_prim_relax_scalar(state, k, end, u_id, ux, uy, min_cost, min_k);
+
+    //a range with only unreachable costs still has a minimum
+    if(min_k == NONE && begin < end)
+        min_k = begin;
+
+    return min_k;
 }
 
-//Solves the problem of getting a full connection of minimum cost.
-void min_cost_full_connection()
+#if defined(__AVX512F__)
+//Loads coordinates of 16 vertices and gets their differences to u's.
+inline __m512 lanes_diff(const float* coords, float u)
 {
-    int n_points;
-    double fiber_thresh;
-    double fiber_cost, normal_cost;
-    std::vector<int> pi;
+    return _mm512_sub_ps(_mm512_loadu_ps(coords), _mm512_set1_ps(u));
+}
+inline __m512 lanes_diff(const int32_t* coords, int32_t u)
+{
+    //(masked conversion avoids a spurious uninitialized warning of gcc)
+    return _mm512_maskz_cvtepi32_ps(0xffff, _mm512_sub_epi32(
+        _mm512_loadu_si512(coords), _mm512_set1_epi32(u)));
+}
+#elif defined(__AVX2__)
+//Loads coordinates of 8 vertices and gets their differences to u's.
+inline __m256 lanes_diff(const float* coords, float u)
+{
+    return _mm256_sub_ps(_mm256_loadu_ps(coords), _mm256_set1_ps(u));
+}
+inline __m256 lanes_diff(const int32_t* coords, int32_t u)
+{
+    return _mm256_cvtepi32_ps(_mm256_sub_epi32(
+        _mm256_loadu_si256((const __m256i*)coords), _mm256_set1_epi32(u)));
+}
+#endif
 
-    std::cin >> n_points;
-    std::cin >> fiber_thresh;
+//Relaxes costs of packed positions [begin, end) against vertex u at (ux, uy)
+//and returns position of the one with minimum cost among them, for
+//precisions with float costs (twice as many per vector as doubles).
+//Returns NONE if range is empty.
+template <class precision>
+int dense_prim_relax(DensePrimState<precision>& state, int begin, int end,
+    int u_id, typename precision::coord_type ux,
+    typename precision::coord_type uy)
+{
+    float min_cost = std::numeric_limits<float>::infinity();
+    int min_k = NONE;
+    int k = begin;
 
-    //building graph from coordinates
-    FullyConnectedGraph graph = fill_graph(n_points);
+#if defined(__AVX2__) || defined(__AVX512F__)
+    typename precision::coord_type* xs = &state.xs[0];
+    typename precision::coord_type* ys = &state.ys[0];
+    float* costs = &state.costs[0];
+    int32_t* parents = &state.parents[0];
+#endif
 
-    //getting costs for connection
-    if(n_points < 2)
+#if defined(__AVX512F__)
+    __m512i vu = _mm512_set1_epi32(u_id);
+    __m512 vmin = _mm512_set1_ps(min_cost);
+    __m512i vmin_k = _mm512_set1_epi32(NONE);
+    __m512i vk = _mm512_add_epi32(_mm512_set1_epi32(k),
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+            8, 9, 10, 11, 12, 13, 14, 15));
+    __m512i vstep = _mm512_set1_epi32(16);
+
+    for(; k+16<=end; k+=16)
     {
-        fiber_cost = 0.0;
-        normal_cost = 0.0;
+        __m512 dx = lanes_diff(xs + k, ux);
+        __m512 dy = lanes_diff(ys + k, uy);
+        __m512 dist = _mm512_fmadd_ps(dx, dx, _mm512_mul_ps(dy, dy));
+        __m512 cost = _mm512_loadu_ps(costs + k);
+        __mmask16 less = _mm512_cmp_ps_mask(dist, cost, _CMP_LT_OQ);
+
+        cost = _mm512_mask_blend_ps(less, cost, dist);
+        _mm512_storeu_ps(costs + k, cost);
+        _mm512_mask_storeu_epi32(parents + k, less, vu);
+
+        __mmask16 is_min = _mm512_cmp_ps_mask(cost, vmin, _CMP_LT_OQ);
+        vmin = _mm512_mask_blend_ps(is_min, vmin, cost);
+        vmin_k = _mm512_mask_blend_epi32(is_min, vmin_k, vk);
+        vk = _mm512_add_epi32(vk, vstep);
     }
-    else
+
+    float lane_min[16];
+    int32_t lane_min_k[16];
+    _mm512_storeu_ps(lane_min, vmin);
+    _mm512_storeu_si512(lane_min_k, vmin_k);
+    for(int i=0; i<16; i++)
+        if(lane_min[i] < min_cost)
+        {
+            min_cost = lane_min[i];
+            min_k = lane_min_k[i];
+        }
+#elif defined(__AVX2__)
+    __m256 vu = _mm256_castsi256_ps(_mm256_set1_epi32(u_id));
+    __m256 vmin = _mm256_set1_ps(min_cost);
+    __m256 vmin_k = _mm256_castsi256_ps(_mm256_set1_epi32(NONE));
+    __m256i vk = _mm256_setr_epi32(k, k+1, k+2, k+3, k+4, k+5, k+6, k+7);
+    __m256i vstep = _mm256_set1_epi32(8);
+
+    for(; k+8<=end; k+=8)
+    {
+        __m256 dx = lanes_diff(xs + k, ux);
+        __m256 dy = lanes_diff(ys + k, uy);
+        __m256 dist = _mm256_add_ps(_mm256_mul_ps(dx, dx),
+            _mm256_mul_ps(dy, dy));
+        __m256 cost = _mm256_loadu_ps(costs + k);
+        __m256 less = _mm256_cmp_ps(dist, cost, _CMP_LT_OQ);
+        __m256 parent = _mm256_loadu_ps((float*)(parents + k));
+
+        cost = _mm256_blendv_ps(cost, dist, less);
+        _mm256_storeu_ps(costs + k, cost);
+        _mm256_storeu_ps((float*)(parents + k),
+            _mm256_blendv_ps(parent, vu, less));
+
+        __m256 is_min = _mm256_cmp_ps(cost, vmin, _CMP_LT_OQ);
+        vmin = _mm256_blendv_ps(vmin, cost, is_min);
+        vmin_k = _mm256_blendv_ps(vmin_k, _mm256_castsi256_ps(vk), is_min);
+        vk = _mm256_add_epi32(vk, vstep);
+    }
+
+    float lane_min[8];
+    int32_t lane_min_k[8];
+    _mm256_storeu_ps(lane_min, vmin);
+    _mm256_storeu_ps((float*)lane_min_k, vmin_k);
+    for(int i=0; i<8; i++)
+        if(lane_min[i] < min_cost)
+        {
+            min_cost = lane_min[i];
+            min_k = lane_min_k[i];
+        }
+#endif
+
+    //scalar loop (also remainder of vectorized loops)
+    dense_prim_relax_scalar(state, k, end, u_id, ux, uy, min_cost, min_k);
+
+    //a range with only unreachable costs still has a minimum
+    if(min_k == NONE && begin < end)
+        min_k = begin;
+
+    return min_k;
+}
+
+//Gets minimum spanning tree of graph, rooted in vertex vtx, via array-based
+//Prim in given precision: no heap is used, each step is one pass that
+//relaxes the costs against the last vertex added and finds the next one.
+//O(n^2) time, O(n) memory.
+//Returns pi, the parents list.
+template <class precision>
+std::vector<int> dense_min_spanning_tree(const EuclideanGraph& graph,
+    int vtx_id)
+{
+    std::vector<int> pi(graph.n_vertices(), NONE);
+    DensePrimState<precision> state(graph);
+    int u_id = vtx_id;
+    typename precision::coord_type ux = state.xs[u_id];
+    typename precision::coord_type uy = state.ys[u_id];
+
+    state.remove(u_id);
+
+    while(state.size > 0)
     {
-        pi = min_spanning_tree(graph, 0);
-        get_dists(graph, pi, fiber_thresh, &normal_cost, &fiber_cost);
+        int k = dense_prim_relax(state, 0, state.size, u_id, ux, uy);
+
+        u_id = state.ids[k];
+        ux = state.xs[k];
+        uy = state.ys[k];
+        pi[u_id] = (int)state.parents[k];
+        state.remove(k);
     }
 
-    std::cout << round(normal_cost) << " " << round(fiber_cost) << std::endl;
+    return pi;
 }
 
-using namespace std;
+/*
+Class representing disjoint sets (union-find).
+Uses union by rank and path halving.
+*/
+class DisjointSets
+{
+    public:
+    //constructors
+    DisjointSets()
+    {;}
+    DisjointSets(int n_elems):
+        parents(n_elems), ranks(n_elems, 0)
+    {
+        for(int i=0; i<n_elems; i++)
+            this->parents[i] = i;
+    }
+    //destructor
+    ~DisjointSets()
+    {;}
+
+    //Returns representative of set containing x.
+    int find(int x)
+    {
+        while(this->parents[x] != x)
+        {
+            this->parents[x] = this->parents[this->parents[x]];
+            x = this->parents[x];
+        }
+
+        return x;
+    }
+
+    //Merges sets containing x and y. Returns false if they were the same.
+    bool merge(int x, int y)
+    {
+        x = this->find(x);
+        y = this->find(y);
+
+        if(x == y)
+            return false;
+
+        if(this->ranks[x] < this->ranks[y])
+            std::swap(x, y);
+        this->parents[y] = x;
+        if(this->ranks[x] == this->ranks[y])
+            this->ranks[x]++;
+
+        return true;
+    }
+
+    private:
+    //parent of element in its set tree
+    std::vector<int> parents;
+    //upper bound of height of element's tree
+    std::vector<int> ranks;
+};
 
-int main()
+//Struct representing a weighted edge (u, v).
+struct WeightedEdge
 {
-    int n_test_cases;
+    WeightedEdge()
+    {;}
+    WeightedEdge(int u_id, int v_id, double cost):
+        u_id(u_id), v_id(v_id), cost(cost)
+    {;}
+    ~WeightedEdge()
+    {;}
 
-    cin >> n_test_cases;
-    for(int i=0; i<n_test_cases; i++)
-        min_cost_full_connection();
+    //edges are ordered by cost
+    bool operator<(const WeightedEdge& edge) const
+    {
+        return this->cost < edge.cost;
+    }
+
+    int u_id;
+    int v_id;
+    double cost;
+};
+
+//Gets minimum spanning forest of graph with n_vertices given by edges
+//(which are sorted in the process) via kruskal.
+//Returns the edges of the forest.
+std::vector<WeightedEdge> kruskal(int n_vertices,
+    std::vector<WeightedEdge>& edges)
+{
+    std::vector<WeightedEdge> tree;
+    DisjointSets sets(n_vertices);
+
+    std::sort(edges.begin(), edges.end());
+
+    for(unsigned i=0; i<edges.size() && (int)tree.size()<n_vertices-1; i++)
+        if(sets.merge(edges[i].u_id, edges[i].v_id))
+            tree.push_back(edges[i]);
+
+    return tree;
+}
+
+//Gets parents list of tree given by edges, rooted in vertex vtx.
+std::vector<int> tree_parents(int n_vertices,
+    const std::vector<WeightedEdge>& edges, int vtx_id)
+{
+    std::vector<int> pi(n_vertices, NONE);
+    //adjacency lists of tree, in compressed form
+    std::vector<int> adj_start(n_vertices+1, 0);
+    std::vector<int> adj(2*edges.size());
+    std::vector<bool> visited(n_vertices, false);
+    std::vector<int> stack;
+
+    for(unsigned i=0; i<edges.size(); i++)
+    {
+        adj_start[edges[i].u_id+1]++;
+        adj_start[edges[i].v_id+1]++;
+    }
+    for(int i=0; i<n_vertices; i++)
+        adj_start[i+1] += adj_start[i];
+    std::vector<int> fill(adj_start.begin(), adj_start.end()-1);
+    for(unsigned i=0; i<edges.size(); i++)
+    {
+        adj[fill[edges[i].u_id]++] = edges[i].v_id;
+        adj[fill[edges[i].v_id]++] = edges[i].u_id;
+    }
+
+    visited[vtx_id] = true;
+    stack.push_back(vtx_id);
+    while(!stack.empty())
+    {
+        int u_id = stack.back();
+        stack.pop_back();
+
+        for(int i=adj_start[u_id]; i<adj_start[u_id+1]; i++)
+            if(!visited[adj[i]])
+            {
+                visited[adj[i]] = true;
+                pi[adj[i]] = u_id;
+                stack.push_back(adj[i]);
+            }
+    }
+
+    return pi;
+}
+
+/*
+Exact geometric predicates.
+A fast floating point evaluation is tried first; if its result is within
+the error bound, the sign is computed exactly using floating point
+expansions (sums of non-overlapping doubles, Shewchuk's method).
+*/
+
+//x + y = a + b exactly.
+void two_sum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    double b_virt = x - a;
+    double a_virt = x - b_virt;
+    y = (a - a_virt) + (b - b_virt);
+}
+
+//Splits a in two non-overlapping halves.
+void split(double a, double& a_hi, double& a_lo)
+{
+    double c = 134217729.0 * a;
+    double a_big = c - a;
+    a_hi = c - a_big;
+    a_lo = a - a_hi;
+}
+
+//x + y = a * b exactly.
+void two_product(double a, double b, double& x, double& y)
+{
+    double a_hi, a_lo, b_hi, b_lo;
+
+    x = a * b;
+    split(a, a_hi, a_lo);
+    split(b, b_hi, b_lo);
+    double err_1 = x - (a_hi * b_hi);
+    double err_2 = err_1 - (a_lo * b_hi);
+    double err_3 = err_2 - (a_hi * b_lo);
+    y = (a_lo * b_lo) - err_3;
+}
+
+//Returns expansion e + f.
+std::vector<double> expansion_sum(const std::vector<double>& e,
+    const std::vector<double>& f)
+{
+    std::vector<double> h = e;
+
+    for(unsigned i=0; i<f.size(); i++)
+    {
+        std::vector<double> g;
+        double q = f[i];
+
+        for(unsigned j=0; j<h.size(); j++)
+        {
+            double sum, err;
+
+            two_sum(q, h[j], sum, err);
+            q = sum;
+            if(err != 0.0)
+                g.push_back(err);
+        }
+        if(q != 0.0)
+            g.push_back(q);
+        h.swap(g);
+    }
+
+    return h;
+}
+
+//Returns expansion e * b.
+std::vector<double> expansion_scale(const std::vector<double>& e, double b)
+{
+    std::vector<double> h;
+    double q, sum, err, prod_hi, prod_lo;
+
+    if(e.empty())
+        return h;
+
+    two_product(e[0], b, q, err);
+    if(err != 0.0)
+        h.push_back(err);
+    for(unsigned i=1; i<e.size(); i++)
+    {
+        two_product(e[i], b, prod_hi, prod_lo);
+        two_sum(q, prod_lo, sum, err);
+        if(err != 0.0)
+            h.push_back(err);
+        two_sum(prod_hi, sum, q, err);
+        if(err != 0.0)
+            h.push_back(err);
+    }
+    if(q != 0.0)
+        h.push_back(q);
+
+    return h;
+}
+
+//Returns expansion e * f.
+std::vector<double> expansion_product(const std::vector<double>& e,
+    const std::vector<double>& f)
+{
+    std::vector<double> h;
+
+    for(unsigned i=0; i<f.size(); i++)
+        h = expansion_sum(h, expansion_scale(e, f[i]));
+
+    return h;
+}
+
+//Returns expansion a - b.
+std::vector<double> expansion_diff(double a, double b)
+{
+    std::vector<double> h;
+    double x, y;
+
+    two_sum(a, -b, x, y);
+    if(y != 0.0)
+        h.push_back(y);
+    if(x != 0.0)
+        h.push_back(x);
+
+    return h;
+}
+
+//Returns expansion -e.
+std::vector<double> expansion_neg(const std::vector<double>& e)
+{
+    std::vector<double> h(e.size());
+
+    for(unsigned i=0; i<e.size(); i++)
+        h[i] = -e[i];
+
+    return h;
+}
+
+//Sign of expansion: the sign of its most significant component.
+double expansion_sign(const std::vector<double>& e)
+{
+    return e.empty()?0.0:e.back();
+}
+
+//Positive if a, b, c are in counterclockwise order, negative if clockwise,
+//zero if collinear.
+double orient_2d(double ax, double ay, double bx, double by,
+    double cx, double cy)
+{
+    double det_left = (ax - cx) * (by - cy);
+    double det_right = (ay - cy) * (bx - cx);
+    double det = det_left - det_right;
+    double err_bound = 3.3306690738754716e-16 *
+        (std::fabs(det_left) + std::fabs(det_right));
+
+    if(det >= err_bound || -det >= err_bound)
+        return det;
+
+    //exact: ax*by - ax*cy - cx*by - ay*bx + ay*cx + cy*bx
+    double terms[6][2] = {{ax, by}, {-ax, cy}, {-cx, by},
+        {-ay, bx}, {ay, cx}, {cy, bx}};
+    std::vector<double> sum;
+    for(int i=0; i<6; i++)
+    {
+        std::vector<double> prod(2);
+        two_product(terms[i][0], terms[i][1], prod[1], prod[0]);
+        sum = expansion_sum(sum, prod);
+    }
+
+    return expansion_sign(sum);
+}
+
+//Positive if d lies inside the circle through a, b, c (which are in
+//counterclockwise order), negative if outside, zero if cocircular.
+double in_circle(double ax, double ay, double bx, double by,
+    double cx, double cy, double dx, double dy)
+{
+    double adx = ax - dx, ady = ay - dy;
+    double bdx = bx - dx, bdy = by - dy;
+    double cdx = cx - dx, cdy = cy - dy;
+    double bdx_cdy = bdx * cdy, cdx_bdy = cdx * bdy;
+    double cdx_ady = cdx * ady, adx_cdy = adx * cdy;
+    double adx_bdy = adx * bdy, bdx_ady = bdx * ady;
+    double a_lift = adx * adx + ady * ady;
+    double b_lift = bdx * bdx + bdy * bdy;
+    double c_lift = cdx * cdx + cdy * cdy;
+    double det = a_lift * (bdx_cdy - cdx_bdy) + b_lift * (cdx_ady - adx_cdy)
+        + c_lift * (adx_bdy - bdx_ady);
+    double permanent = (std::fabs(bdx_cdy) + std::fabs(cdx_bdy)) * a_lift
+        + (std::fabs(cdx_ady) + std::fabs(adx_cdy)) * b_lift
+        + (std::fabs(adx_bdy) + std::fabs(bdx_ady)) * c_lift;
+    double err_bound = 1.1102230246251577e-15 * permanent;
+
+    if(det > err_bound || -det > err_bound)
+        return det;
+
+    //exact evaluation
+    std::vector<double> adx_e = expansion_diff(ax, dx);
+    std::vector<double> ady_e = expansion_diff(ay, dy);
+    std::vector<double> bdx_e = expansion_diff(bx, dx);
+    std::vector<double> bdy_e = expansion_diff(by, dy);
+    std::vector<double> cdx_e = expansion_diff(cx, dx);
+    std::vector<double> cdy_e = expansion_diff(cy, dy);
+    std::vector<double> a_lift_e = expansion_sum(
+        expansion_product(adx_e, adx_e), expansion_product(ady_e, ady_e));
+    std::vector<double> b_lift_e = expansion_sum(
+        expansion_product(bdx_e, bdx_e), expansion_product(bdy_e, bdy_e));
+    std::vector<double> c_lift_e = expansion_sum(
+        expansion_product(cdx_e, cdx_e), expansion_product(cdy_e, cdy_e));
+    std::vector<double> bc = expansion_sum(expansion_product(bdx_e, cdy_e),
+        expansion_neg(expansion_product(cdx_e, bdy_e)));
+    std::vector<double> ca = expansion_sum(expansion_product(cdx_e, ady_e),
+        expansion_neg(expansion_product(adx_e, cdy_e)));
+    std::vector<double> ab = expansion_sum(expansion_product(adx_e, bdy_e),
+        expansion_neg(expansion_product(bdx_e, ady_e)));
+
+    return expansion_sign(expansion_sum(expansion_product(a_lift_e, bc),
+        expansion_sum(expansion_product(b_lift_e, ca),
+            expansion_product(c_lift_e, ab))));
+}
+
+/*
+Class representing a delaunay triangulation of points in the plane.
+Built by Guibas and Stolfi's divide and conquer algorithm in O(n log n).
+The subdivision is kept in a quad-edge structure stored in flat arrays:
+edge e has quarter-edges 4e..4e+3, each with its 'onext' and origin.
+Points must be sorted by x, then y, with no repetitions.
+*/
+class DelaunayTriangulation
+{
+    public:
+    //constructor
+    DelaunayTriangulation(const std::vector<double>& xs,
+        const std::vector<double>& ys):
+        xs(xs), ys(ys)
+    {
+        this->onexts.reserve(4 * 3 * xs.size());
+        this->origins.reserve(4 * 3 * xs.size());
+        if(xs.size() >= 2)
+            this->triangulate(0, (int)xs.size());
+    }
+    //destructor
+    ~DelaunayTriangulation()
+    {;}
+
+    //Gets edges of triangulation. Vertices ids are positions in points.
+    std::vector<std::pair<int, int> > edges() const
+    {
+        std::vector<std::pair<int, int> > edges;
+
+        for(unsigned q=0; q<this->origins.size(); q+=4)
+            if(this->origins[q] != NONE)
+                edges.push_back(std::make_pair(this->origins[q],
+                    this->origins[q+2]));
+
+        return edges;
+    }
+
+    private:
+    //coordinates of points
+    const std::vector<double>& xs;
+    const std::vector<double>& ys;
+    //next quarter-edge counterclockwise with same origin
+    std::vector<int> onexts;
+    //origin point of quarter-edge (NONE for dual ones and deleted edges)
+    std::vector<int> origins;
+
+    //quad-edge navigation
+    static int rot(int e)
+    {
+        return (e & ~3) | ((e + 1) & 3);
+    }
+    static int sym(int e)
+    {
+        return (e & ~3) | ((e + 2) & 3);
+    }
+    static int rot_inv(int e)
+    {
+        return (e & ~3) | ((e + 3) & 3);
+    }
+    int onext(int e) const
+    {
+        return this->onexts[e];
+    }
+    int oprev(int e) const
+    {
+        return rot(this->onext(rot(e)));
+    }
+    int lnext(int e) const
+    {
+        return rot(this->onext(rot_inv(e)));
+    }
+    int rprev(int e) const
+    {
+        return this->onext(sym(e));
+    }
+    int org(int e) const
+    {
+        return this->origins[e];
+    }
+    int dest(int e) const
+    {
+        return this->origins[sym(e)];
+    }
+
+    //Creates isolated edge from point a to point b.
+    int make_edge(int a, int b)
+    {
+        int e = (int)this->onexts.size();
+
+        this->onexts.push_back(e);
+        this->onexts.push_back(e+3);
+        this->onexts.push_back(e+2);
+        this->onexts.push_back(e+1);
+        this->origins.push_back(a);
+        this->origins.push_back(NONE);
+        this->origins.push_back(b);
+        this->origins.push_back(NONE);
+
+        return e;
+    }
+
+    //Joins or separates rings of a and b.
+    void splice(int a, int b)
+    {
+        int alpha = rot(this->onext(a));
+        int beta = rot(this->onext(b));
+
+        std::swap(this->onexts[a], this->onexts[b]);
+        std::swap(this->onexts[alpha], this->onexts[beta]);
+    }
+
+    //Creates edge from destination of a to origin of b.
+    int connect(int a, int b)
+    {
+        int e = this->make_edge(this->dest(a), this->org(b));
+
+        this->splice(e, this->lnext(a));
+        this->splice(sym(e), b);
+
+        return e;
+    }
+
+    //Removes edge e from subdivision.
+    void delete_edge(int e)
+    {
+        this->splice(e, this->oprev(e));
+        this->splice(sym(e), this->oprev(sym(e)));
+        this->origins[e & ~3] = NONE;
+        this->origins[(e & ~3) + 2] = NONE;
+    }
+
+    //Predicates over points ids.
+    bool ccw(int a, int b, int c) const
+    {
+        return orient_2d(this->xs[a], this->ys[a], this->xs[b], this->ys[b],
+            this->xs[c], this->ys[c]) > 0;
+    }
+    bool right_of(int x, int e) const
+    {
+        return this->ccw(x, this->dest(e), this->org(e));
+    }
+    bool left_of(int x, int e) const
+    {
+        return this->ccw(x, this->org(e), this->dest(e));
+    }
+    bool in_circle(int a, int b, int c, int d) const
+    {
+        return ::in_circle(this->xs[a], this->ys[a], this->xs[b], this->ys[b],
+            this->xs[c], this->ys[c], this->xs[d], this->ys[d]) > 0;
+    }
+
+    //Triangulates points [lo, hi).
+    //Returns counterclockwise convex hull edge out of leftmost point and
+    //clockwise convex hull edge out of rightmost point.
+    std::pair<int, int> triangulate(int lo, int hi)
+    {
+        if(hi - lo == 2)
+        {
+            int a = this->make_edge(lo, lo+1);
+            return std::make_pair(a, sym(a));
+        }
+
+        if(hi - lo == 3)
+        {
+            int a = this->make_edge(lo, lo+1);
+            int b = this->make_edge(lo+1, lo+2);
+            this->splice(sym(a), b);
+
+            if(this->ccw(lo, lo+1, lo+2))
+            {
+                this->connect(b, a);
+                return std::make_pair(a, sym(b));
+            }
+            if(this->ccw(lo, lo+2, lo+1))
+            {
+                int c = this->connect(b, a);
+                return std::make_pair(sym(c), c);
+            }
+            //collinear points
+            return std::make_pair(a, sym(b));
+        }
+
+        int mid = (lo + hi) / 2;
+        std::pair<int, int> left = this->triangulate(lo, mid);
+        std::pair<int, int> right = this->triangulate(mid, hi);
+        int ldo = left.first, ldi = left.second;
+        int rdi = right.first, rdo = right.second;
+
+        //finding lower common tangent of left and right hulls
+        while(true)
+        {
+            if(this->left_of(this->org(rdi), ldi))
+                ldi = this->lnext(ldi);
+            else if(this->right_of(this->org(ldi), rdi))
+                rdi = this->rprev(rdi);
+            else
+                break;
+        }
+
+        int base = this->connect(sym(rdi), ldi);
+        if(this->org(ldi) == this->org(ldo))
+            ldo = sym(base);
+        if(this->org(rdi) == this->org(rdo))
+            rdo = base;
+
+        //merging, from bottom to top
+        while(true)
+        {
+            int lcand = this->onext(sym(base));
+            bool l_valid = this->right_of(this->dest(lcand), base);
+            if(l_valid)
+                while(this->in_circle(this->dest(base), this->org(base),
+                    this->dest(lcand), this->dest(this->onext(lcand))))
+                {
+                    int next = this->onext(lcand);
+                    this->delete_edge(lcand);
+                    lcand = next;
+                }
+
+            int rcand = this->oprev(base);
+            bool r_valid = this->right_of(this->dest(rcand), base);
+            if(r_valid)
+                while(this->in_circle(this->dest(base), this->org(base),
+                    this->dest(rcand), this->dest(this->oprev(rcand))))
+                {
+                    int next = this->oprev(rcand);
+                    this->delete_edge(rcand);
+                    rcand = next;
+                }
+
+            if(!l_valid && !r_valid)
+                break;
+
+            if(!l_valid || (r_valid && this->in_circle(this->dest(lcand),
+                this->org(lcand), this->org(rcand), this->dest(rcand))))
+                base = this->connect(rcand, sym(base));
+            else
+                base = this->connect(sym(base), sym(lcand));
+        }
+
+        return std::make_pair(ldo, rdo);
+    }
+};
+
+//Compares vertices by x, then y.
+struct PointLess
+{
+    PointLess(const EuclideanGraph& graph): graph(graph)
+    {;}
+
+    bool operator()(int u_id, int v_id) const
+    {
+        if(this->graph.get_x(u_id) != this->graph.get_x(v_id))
+            return this->graph.get_x(u_id) < this->graph.get_x(v_id);
+        return this->graph.get_y(u_id) < this->graph.get_y(v_id);
+    }
+
+    const EuclideanGraph& graph;
+};
+
+//Gets minimum spanning tree of graph, rooted in vertex vtx, via kruskal
+//over the edges of the delaunay triangulation of its points, which contain
+//the euclidean minimum spanning tree. O(n log n).
+//Returns pi, the parents list.
+std::vector<int> delaunay_min_spanning_tree(const EuclideanGraph& graph,
+    int vtx_id)
+{
+    //vertices ids sorted by coordinates
+    std::vector<int> order = seq(0, graph.n_vertices()-1);
+    std::vector<double> xs;
+    std::vector<double> ys;
+    //vertices ids of distinct points
+    std::vector<int> ids;
+    std::vector<WeightedEdge> edges;
+
+    std::sort(order.begin(), order.end(), PointLess(graph));
+
+    //repeated points are joined to their first copy by zero cost edges
+    for(unsigned i=0; i<order.size(); i++)
+    {
+        int u_id = order[i];
+
+        if(!ids.empty() && graph.get_x(u_id) == xs.back() &&
+            graph.get_y(u_id) == ys.back())
+        {
+            edges.push_back(WeightedEdge(ids.back(), u_id, 0.0));
+            continue;
+        }
+
+        xs.push_back(graph.get_x(u_id));
+        ys.push_back(graph.get_y(u_id));
+        ids.push_back(u_id);
+    }
+
+    std::vector<std::pair<int, int> > dt_edges =
+        DelaunayTriangulation(xs, ys).edges();
+    for(unsigned i=0; i<dt_edges.size(); i++)
+    {
+        int u_id = ids[dt_edges[i].first];
+        int v_id = ids[dt_edges[i].second];
+        edges.push_back(WeightedEdge(u_id, v_id,
+            graph.get_edge_cost(u_id, v_id)));
+    }
+
+    return tree_parents(graph.n_vertices(),
+        kruskal(graph.n_vertices(), edges), vtx_id);
+}
+
+//True if edge (u1, v1) with squared cost c1 comes before edge (u2, v2)
+//with squared cost c2. Ties in cost are broken by vertices ids, so every
+//edge has a distinct key.
+bool edge_key_less(double c1, int u1, int v1, double c2, int u2, int v2)
+{
+    if(c1 != c2)
+        return c1 < c2;
+    if(std::min(u1, v1) != std::min(u2, v2))
+        return std::min(u1, v1) < std::min(u2, v2);
+    return std::max(u1, v1) < std::max(u2, v2);
+}
+
+/*
+Class representing a k-d tree over points of any dimension.
+Points are copied in tree order (dim coordinates per point, contiguous),
+so each node covers a range of positions. Nodes keep their bounding boxes.
+Points are referred to by their position in the tree.
+*/
+class KDTree
+{
+    public:
+    //constructor. coords has dim coordinates per point.
+    KDTree(const std::vector<double>& coords, int dim, int leaf_size=8):
+        dim(dim), leaf_size(leaf_size), ids(seq(0, (int)coords.size()/dim-1))
+    {
+        this->build(coords, 0, this->n_points());
+
+        this->points.resize(coords.size());
+        for(int i=0; i<this->n_points(); i++)
+            for(int d=0; d<dim; d++)
+                this->points[i*dim + d] = coords[this->ids[i]*dim + d];
+    }
+    //destructor
+    ~KDTree()
+    {;}
+
+    //Returns number of points in tree.
+    int n_points() const
+    {
+        return (int)this->ids.size();
+    }
+
+    //Returns original id of point at position pos.
+    int id(int pos) const
+    {
+        return this->ids[pos];
+    }
+
+    //Squared distance between points at positions p and q.
+    double sqr_dist(int p, int q) const
+    {
+        const double* a = &this->points[p * this->dim];
+        const double* b = &this->points[q * this->dim];
+        double dist = 0.0;
+
+        for(int d=0; d<this->dim; d++)
+            dist += sqr(a[d] - b[d]);
+
+        return dist;
+    }
+
+    //Labels each node with the label shared by all its points,
+    //or NONE if they differ.
+    void label_nodes(const std::vector<int>& labels,
+        std::vector<int>& node_labels) const
+    {
+        node_labels.resize(this->begins.size());
+
+        for(int node=(int)this->begins.size()-1; node>=0; node--)
+        {
+            if(this->lefts[node] == NONE)
+            {
+                int label = labels[this->begins[node]];
+                for(int i=this->begins[node]+1; i<this->ends[node]; i++)
+                    if(labels[i] != label)
+                    {
+                        label = NONE;
+                        break;
+                    }
+                node_labels[node] = label;
+            }
+            else
+            {
+                int left_label = node_labels[this->lefts[node]];
+                int right_label = node_labels[this->rights[node]];
+                node_labels[node] = (left_label == right_label)?
+                    left_label:NONE;
+            }
+        }
+    }
+
+    //Finds point nearest to point at position p whose label differs from
+    //the label of p, searching only up to squared distance bound.
+    //best_dist/best keep the best found (best is NONE if none).
+    void nearest_foreign(int p, const std::vector<int>& labels,
+        const std::vector<int>& node_labels, double bound,
+        double* best_dist, int* best) const
+    {
+        *best_dist = std::numeric_limits<double>::infinity();
+        *best = NONE;
+        this->_nearest_foreign(0, p, labels, node_labels, bound,
+            best_dist, best);
+    }
+
+    private:
+    //number of dimensions
+    int dim;
+    //maximum number of points in leaf nodes
+    int leaf_size;
+    //original id of point in each position
+    std::vector<int> ids;
+    //coordinates of points, in tree order
+    std::vector<double> points;
+    //range of positions of each node
+    std::vector<int> begins;
+    std::vector<int> ends;
+    //children of each node (NONE for leaves)
+    std::vector<int> lefts;
+    std::vector<int> rights;
+    //bounding box of each node (dim coordinates per node)
+    std::vector<double> los;
+    std::vector<double> his;
+
+    //Builds node over positions [begin, end). Returns its index.
+    int build(const std::vector<double>& coords, int begin, int end)
+    {
+        int node = (int)this->begins.size();
+        int split_dim = 0;
+        double split_extent = -1.0;
+
+        this->begins.push_back(begin);
+        this->ends.push_back(end);
+        this->lefts.push_back(NONE);
+        this->rights.push_back(NONE);
+
+        for(int d=0; d<this->dim; d++)
+        {
+            double lo = std::numeric_limits<double>::infinity();
+            double hi = -lo;
+
+            for(int i=begin; i<end; i++)
+            {
+                lo = std::min(lo, coords[this->ids[i]*this->dim + d]);
+                hi = std::max(hi, coords[this->ids[i]*this->dim + d]);
+            }
+            this->los.push_back(lo);
+            this->his.push_back(hi);
+
+            if(hi - lo > split_extent)
+            {
+                split_extent = hi - lo;
+                split_dim = d;
+            }
+        }
+
+        if(end - begin <= this->leaf_size)
+            return node;
+
+        int mid = (begin + end) / 2;
+        std::nth_element(this->ids.begin()+begin, this->ids.begin()+mid,
+            this->ids.begin()+end, CoordLess(coords, this->dim, split_dim));
+
+        int left = this->build(coords, begin, mid);
+        int right = this->build(coords, mid, end);
+        this->lefts[node] = left;
+        this->rights[node] = right;
+
+        return node;
+    }
+
+    //Compares points ids by one coordinate.
+    struct CoordLess
+    {
+        CoordLess(const std::vector<double>& coords, int dim, int d):
+            coords(coords), dim(dim), d(d)
+        {;}
+
+        bool operator()(int u_id, int v_id) const
+        {
+            return this->coords[u_id*this->dim + this->d] <
+                this->coords[v_id*this->dim + this->d];
+        }
+
+        const std::vector<double>& coords;
+        int dim;
+        int d;
+    };
+
+    //Squared distance from point at position p to bounding box of node.
+    double box_sqr_dist(int node, int p) const
+    {
+        const double* a = &this->points[p * this->dim];
+        double dist = 0.0;
+
+        for(int d=0; d<this->dim; d++)
+        {
+            double lo = this->los[node*this->dim + d];
+            double hi = this->his[node*this->dim + d];
+
+            if(a[d] < lo)
+                dist += sqr(lo - a[d]);
+            else if(a[d] > hi)
+                dist += sqr(a[d] - hi);
+        }
+
+        return dist;
+    }
+
+    //nearest_foreign auxiliar.
+    void _nearest_foreign(int node, int p, const std::vector<int>& labels,
+        const std::vector<int>& node_labels, double bound,
+        double* best_dist, int* best) const
+    {
+        if(node_labels[node] == labels[p])
+            return;
+        if(this->box_sqr_dist(node, p) > std::min(bound, *best_dist))
+            return;
+
+        if(this->lefts[node] == NONE)
+        {
+            for(int q=this->begins[node]; q<this->ends[node]; q++)
+            {
+                if(labels[q] == labels[p])
+                    continue;
+
+                double dist = this->sqr_dist(p, q);
+                if(dist <= bound && (*best == NONE ||
+                    edge_key_less(dist, p, q, *best_dist, p, *best)))
+                {
+                    *best_dist = dist;
+                    *best = q;
+                }
+            }
+
+            return;
+        }
+
+        int near = this->lefts[node];
+        int far = this->rights[node];
+        if(this->box_sqr_dist(far, p) < this->box_sqr_dist(near, p))
+            std::swap(near, far);
+        this->_nearest_foreign(near, p, labels, node_labels, bound,
+            best_dist, best);
+        this->_nearest_foreign(far, p, labels, node_labels, bound,
+            best_dist, best);
+    }
+};
+
+/*
+One round of boruvka: finds, for each point, its nearest point in another
+component. Points are split among threads; each thread keeps the best
+squared distance found so far for each component to prune its searches.
+*/
+class BoruvkaRound: public ParallelTask
+{
+    public:
+    //constructor
+    BoruvkaRound(const KDTree& tree, const std::vector<int>& labels,
+        const std::vector<int>& node_labels, int n_threads):
+        tree(tree), labels(labels), node_labels(node_labels),
+        best_dists(tree.n_points()), bests(tree.n_points()),
+        bounds(n_threads)
+    {;}
+    //destructor
+    ~BoruvkaRound()
+    {;}
+
+    void run(int thread_id, int n_threads)
+    {
+        std::vector<double>& comp_bounds = this->bounds[thread_id];
+        int begin, end;
+
+        comp_bounds.assign(this->tree.n_points(),
+            std::numeric_limits<double>::infinity());
+        thread_range(this->tree.n_points(), thread_id, n_threads,
+            &begin, &end);
+
+        for(int p=begin; p<end; p++)
+        {
+            int label = this->labels[p];
+
+            this->tree.nearest_foreign(p, this->labels, this->node_labels,
+                comp_bounds[label], &this->best_dists[p], &this->bests[p]);
+            if(this->bests[p] != NONE)
+                comp_bounds[label] = std::min(comp_bounds[label],
+                    this->best_dists[p]);
+        }
+    }
+
+    //tree of points
+    const KDTree& tree;
+    //component of each point
+    const std::vector<int>& labels;
+    //component of each tree node
+    const std::vector<int>& node_labels;
+    //nearest foreign point of each point and its squared distance
+    std::vector<double> best_dists;
+    std::vector<int> bests;
+    //per-thread best squared distance of each component
+    std::vector<std::vector<double> > bounds;
+};
+
+//Gets euclidean minimum spanning tree of points (dim coordinates each)
+//via boruvka: at each round every component is joined to its nearest
+//component, found with nearest neighbour queries on a k-d tree that skip
+//subtrees inside the component. Rounds run on the threads of pool.
+//Returns the edges of the tree, with squared costs.
+std::vector<WeightedEdge> boruvka_emst(const std::vector<double>& coords,
+    int dim, ThreadPool& pool)
+{
+    KDTree tree(coords, dim);
+    int n_points = tree.n_points();
+    DisjointSets sets(n_points);
+    std::vector<int> labels = seq(0, n_points-1);
+    std::vector<int> node_labels;
+    std::vector<WeightedEdge> edges;
+    //best edge leaving each component
+    std::vector<int> comp_us(n_points, NONE);
+    std::vector<int> comp_vs(n_points, NONE);
+    std::vector<double> comp_dists(n_points, 0.0);
+
+    while((int)edges.size() < n_points-1)
+    {
+        tree.label_nodes(labels, node_labels);
+
+        BoruvkaRound boruvka_round(tree, labels, node_labels,
+            pool.n_threads());
+        pool.run(boruvka_round);
+
+        for(int p=0; p<n_points; p++)
+        {
+            int c = labels[p];
+            int q = boruvka_round.bests[p];
+
+            if(q == NONE)
+                continue;
+            if(comp_us[c] == NONE || edge_key_less(
+                boruvka_round.best_dists[p], p, q,
+                comp_dists[c], comp_us[c], comp_vs[c]))
+            {
+                comp_us[c] = p;
+                comp_vs[c] = q;
+                comp_dists[c] = boruvka_round.best_dists[p];
+            }
+        }
+
+        for(int c=0; c<n_points; c++)
+        {
+            if(comp_us[c] == NONE)
+                continue;
+            if(sets.merge(comp_us[c], comp_vs[c]))
+                edges.push_back(WeightedEdge(tree.id(comp_us[c]),
+                    tree.id(comp_vs[c]), comp_dists[c]));
+            comp_us[c] = NONE;
+        }
+
+        for(int p=0; p<n_points; p++)
+            labels[p] = sets.find(p);
+    }
+
+    return edges;
+}
+
+//Gets minimum spanning tree of graph, rooted in vertex vtx, via boruvka
+//over a k-d tree of its points.
+//Returns pi, the parents list.
+std::vector<int> boruvka_min_spanning_tree(const EuclideanGraph& graph,
+    int vtx_id, ThreadPool& pool)
+{
+    std::vector<double> coords(2*graph.n_vertices());
+
+    for(int i=0; i<graph.n_vertices(); i++)
+    {
+        coords[2*i] = graph.get_x(i);
+        coords[2*i+1] = graph.get_y(i);
+    }
+
+    return tree_parents(graph.n_vertices(),
+        boruvka_emst(coords, 2, pool), vtx_id);
+}
+
+/*
+Array-based prim with the relaxation of each step split among the threads
+of a pool. Each thread relaxes its range of the pending vertices and finds
+its local minimum; after a barrier, one thread reduces the minima and adds
+the chosen vertex to the tree, and after another barrier the next step
+starts.
+*/
+class ParallelPrim: public ParallelTask
+{
+    public:
+    //constructor
+    ParallelPrim(const EuclideanGraph& graph, int vtx_id, ThreadPool& pool):
+        pi(graph.n_vertices(), NONE), state(graph), pool(pool),
+        minima(pool.n_threads()), u_id(vtx_id),
+        ux(graph.get_x(vtx_id)), uy(graph.get_y(vtx_id))
+    {
+        this->state.remove(vtx_id);
+    }
+    //destructor
+    ~ParallelPrim()
+    {;}
+
+    void run(int thread_id, int n_threads)
+    {
+        while(this->state.size > 0)
+        {
+            int begin, end;
+
+            thread_range(this->state.size, thread_id, n_threads,
+                &begin, &end);
+            this->minima[thread_id].pos = dense_prim_relax(this->state,
+                begin, end, this->u_id, this->ux, this->uy);
+
+            if(this->pool.barrier())
+                this->add_min();
+            this->pool.barrier();
+        }
+    }
+
+    //parents list
+    std::vector<int> pi;
+
+    private:
+    //minimum found by a thread, alone in its cache line
+    struct LocalMin
+    {
+        int pos;
+        char padding[64 - sizeof(int)];
+    };
+
+    DensePrimState<DoublePrecision> state;
+    ThreadPool& pool;
+    std::vector<LocalMin> minima;
+    //last vertex added to tree and its coordinates
+    int u_id;
+    double ux;
+    double uy;
+
+    //Adds pending vertex with minimum cost among threads minima to tree.
+    void add_min()
+    {
+        int k = NONE;
+
+        for(unsigned i=0; i<this->minima.size(); i++)
+        {
+            int pos = this->minima[i].pos;
+            if(pos != NONE && (k == NONE ||
+                this->state.costs[pos] < this->state.costs[k]))
+                k = pos;
+        }
+
+        this->u_id = this->state.ids[k];
+        this->ux = this->state.xs[k];
+        this->uy = this->state.ys[k];
+        this->pi[this->u_id] = (int)this->state.parents[k];
+        this->state.remove(k);
+    }
+};
+
+//Gets minimum spanning tree of graph, rooted in vertex vtx, via array-based
+//prim with each step divided among the threads of pool.
+//Returns pi, the parents list.
+std::vector<int> parallel_min_spanning_tree(const EuclideanGraph& graph,
+    int vtx_id, ThreadPool& pool)
+{
+    ParallelPrim prim(graph, vtx_id, pool);
+
+    pool.run(prim);
+
+    return prim.pi;
+}
+
+/*
+Class representing a forest of link-cut trees (Sleator and Tarjan).
+Each node has a value; paths can be queried for the node of maximum value.
+Preferred paths are kept in splay trees stored in flat arrays.
+All operations take O(log n) amortized time.
+*/
+class LinkCutTree
+{
+    public:
+    //constructor
+    LinkCutTree()
+    {;}
+    //destructor
+    ~LinkCutTree()
+    {;}
+
+    //Adds isolated node with value val. Returns its id.
+    int add_node(double val)
+    {
+        this->lefts.push_back(NONE);
+        this->rights.push_back(NONE);
+        this->parents.push_back(NONE);
+        this->reversed.push_back(false);
+        this->vals.push_back(val);
+        this->maxs.push_back((int)this->vals.size() - 1);
+
+        return (int)this->vals.size() - 1;
+    }
+
+    //Sets value of isolated node x.
+    void set_val(int x, double val)
+    {
+        this->vals[x] = val;
+        this->maxs[x] = x;
+    }
+
+    //Gets value of node x.
+    double get_val(int x) const
+    {
+        return this->vals[x];
+    }
+
+    //True if x and y are in the same tree.
+    bool connected(int x, int y)
+    {
+        return this->find_root(x) == this->find_root(y);
+    }
+
+    //Adds edge (x, y). x and y must be in different trees.
+    void link(int x, int y)
+    {
+        this->make_root(x);
+        this->parents[x] = y;
+    }
+
+    //Removes edge (x, y), which must exist.
+    void cut(int x, int y)
+    {
+        this->make_root(x);
+        this->access(y);
+        this->lefts[y] = NONE;
+        this->parents[x] = NONE;
+        this->pull(y);
+    }
+
+    //Gets node of maximum value in path from x to y (same tree).
+    int path_max(int x, int y)
+    {
+        this->make_root(x);
+        this->access(y);
+
+        return this->maxs[y];
+    }
+
+    private:
+    //children in splay tree
+    std::vector<int> lefts;
+    std::vector<int> rights;
+    //parent in splay tree, or path-parent if node is splay root
+    std::vector<int> parents;
+    //true if children of node must be swapped (lazy path reversal)
+    std::vector<bool> reversed;
+    //values of nodes
+    std::vector<double> vals;
+    //node of maximum value in splay subtree
+    std::vector<int> maxs;
+
+    //True if x is root of its splay tree.
+    bool is_splay_root(int x) const
+    {
+        int p = this->parents[x];
+        return p == NONE || (this->lefts[p] != x && this->rights[p] != x);
+    }
+
+    //Propagates reversal of x to its children.
+    void push(int x)
+    {
+        if(!this->reversed[x])
+            return;
+
+        std::swap(this->lefts[x], this->rights[x]);
+        if(this->lefts[x] != NONE)
+            this->reversed[this->lefts[x]] = !this->reversed[this->lefts[x]];
+        if(this->rights[x] != NONE)
+            this->reversed[this->rights[x]] =
+                !this->reversed[this->rights[x]];
+        this->reversed[x] = false;
+    }
+
+    //Updates maximum of x from its children.
+    void pull(int x)
+    {
+        int children[2] = {this->lefts[x], this->rights[x]};
+
+        this->maxs[x] = x;
+        for(int i=0; i<2; i++)
+            if(children[i] != NONE &&
+                this->vals[this->maxs[children[i]]] > this->vals[this->maxs[x]])
+                this->maxs[x] = this->maxs[children[i]];
+    }
+
+    //Rotates x over its parent.
+    void rotate(int x)
+    {
+        int p = this->parents[x];
+        int g = this->parents[p];
+
+        if(!this->is_splay_root(p))
+        {
+            if(this->lefts[g] == p)
+                this->lefts[g] = x;
+            else
+                this->rights[g] = x;
+        }
+        this->parents[x] = g;
+
+        if(this->lefts[p] == x)
+        {
+            this->lefts[p] = this->rights[x];
+            if(this->rights[x] != NONE)
+                this->parents[this->rights[x]] = p;
+            this->rights[x] = p;
+        }
+        else
+        {
+            this->rights[p] = this->lefts[x];
+            if(this->lefts[x] != NONE)
+                this->parents[this->lefts[x]] = p;
+            this->lefts[x] = p;
+        }
+        this->parents[p] = x;
+
+        this->pull(p);
+        this->pull(x);
+    }
+
+    //Makes x root of its splay tree.
+    void splay(int x)
+    {
+        std::vector<int>& path = this->path_buffer;
+
+        //pushing reversals from splay root down to x
+        path.clear();
+        path.push_back(x);
+        for(int y=x; !this->is_splay_root(y); y=this->parents[y])
+            path.push_back(this->parents[y]);
+        for(int i=(int)path.size()-1; i>=0; i--)
+            this->push(path[i]);
+
+        while(!this->is_splay_root(x))
+        {
+            int p = this->parents[x];
+
+            if(!this->is_splay_root(p))
+            {
+                int g = this->parents[p];
+                bool zig_zig = (this->lefts[g] == p) == (this->lefts[p] == x);
+                this->rotate(zig_zig?p:x);
+            }
+            this->rotate(x);
+        }
+    }
+
+    //Makes path from root of x's tree to x preferred, x at its splay root.
+    void access(int x)
+    {
+        int last = NONE;
+
+        for(int y=x; y!=NONE; y=this->parents[y])
+        {
+            this->splay(y);
+            this->rights[y] = last;
+            this->pull(y);
+            last = y;
+        }
+        this->splay(x);
+    }
+
+    //Makes x root of its tree.
+    void make_root(int x)
+    {
+        this->access(x);
+        this->reversed[x] = !this->reversed[x];
+    }
+
+    //Gets root of x's tree.
+    int find_root(int x)
+    {
+        this->access(x);
+        this->push(x);
+        while(this->lefts[x] != NONE)
+        {
+            x = this->lefts[x];
+            this->push(x);
+        }
+        this->splay(x);
+
+        return x;
+    }
+
+    //nodes from x to its splay root, used by splay
+    std::vector<int> path_buffer;
+};
+
+//number of cones around a point for incremental mst (each of 60 degrees)
+#define N_CONES 6
+//pi, as M_PI is not in ansi c++
+#define PI 3.14159265358979323846
+//rotation of cones, so that grid directions do not lie on their borders
+#define CONE_OFFSET (PI/12)
+
+//Gets cone (0 to N_CONES-1) of direction (dx, dy).
+int cone(double dx, double dy)
+{
+    double angle = atan2(dy, dx) + PI - CONE_OFFSET;
+
+    if(angle < 0)
+        angle += 2*PI;
+    return ((int)(angle / (2*PI / N_CONES))) % N_CONES;
+}
+
+//Gets bit mask of cones around (x, y) which box [lo_x, hi_x]x[lo_y, hi_y]
+//may touch.
+int box_cone_mask(double x, double y, double lo_x, double hi_x,
+    double lo_y, double hi_y)
+{
+    if(x >= lo_x && x <= hi_x && y >= lo_y && y <= hi_y)
+        return (1 << N_CONES) - 1;
+
+    //angular interval of box, relative to direction of its center
+    double center = atan2((lo_y + hi_y)/2 - y, (lo_x + hi_x)/2 - x);
+    double corners[4][2] = {{lo_x, lo_y}, {lo_x, hi_y},
+        {hi_x, lo_y}, {hi_x, hi_y}};
+    double lo = 0.0, hi = 0.0;
+    for(int i=0; i<4; i++)
+    {
+        double diff = atan2(corners[i][1] - y, corners[i][0] - x) - center;
+        if(diff > PI)
+            diff -= 2*PI;
+        else if(diff < -PI)
+            diff += 2*PI;
+        lo = std::min(lo, diff);
+        hi = std::max(hi, diff);
+    }
+
+    //cones from the one of lo to the one of hi, with a safety margin
+    double width = 2*PI / N_CONES;
+    int first = (int)floor((center + lo + PI - CONE_OFFSET - 1e-9)/width);
+    int last = (int)floor((center + hi + PI - CONE_OFFSET + 1e-9)/width);
+    int mask = 0;
+    for(int i=first; i<=last; i++)
+        mask |= 1 << (((i % N_CONES) + N_CONES) % N_CONES);
+
+    return mask;
+}
+
+//Squared distance from (x, y) to box [lo_x, hi_x]x[lo_y, hi_y].
+double box_sqr_dist(double x, double y, double lo_x, double hi_x,
+    double lo_y, double hi_y)
+{
+    double dx = std::max(0.0, std::max(lo_x - x, x - hi_x));
+    double dy = std::max(0.0, std::max(lo_y - y, y - hi_y));
+
+    return dx*dx + dy*dy;
+}
+
+//Compares ids of points by one of their coordinates.
+struct CoordLess
+{
+    CoordLess(const std::vector<double>& coords): coords(coords)
+    {;}
+
+    bool operator()(int u_id, int v_id) const
+    {
+        return this->coords[u_id] < this->coords[v_id];
+    }
+
+    const std::vector<double>& coords;
+};
+
+/*
+Class representing a k-d tree with insertion of points in the plane.
+Each node is a point; nodes keep bounding boxes and sizes of their subtrees.
+Balance is kept as in scapegoat trees: when an insertion makes a subtree too
+unbalanced, it is rebuilt splitting at medians, so insertions take
+O(log^2 n) amortized time even for sorted inputs.
+Answers, for a point, its nearest point in each of the N_CONES cones around
+it, which include all its neighbours in the euclidean minimum spanning tree.
+*/
+class DynamicKDTree
+{
+    public:
+    //constructors
+    DynamicKDTree(): root(NONE)
+    {;}
+    //Builds balanced tree over n_points points, given as x0 y0 x1 y1 ...
+    DynamicKDTree(const double* points, int n_points):
+        root(NONE), sizes(n_points), xs(n_points), ys(n_points),
+        lefts(n_points), rights(n_points), x_los(n_points), x_his(n_points),
+        y_los(n_points), y_his(n_points)
+    {
+        std::vector<int> ids = seq(0, n_points-1);
+
+        for(int i=0; i<n_points; i++)
+        {
+            this->xs[i] = points[2*i];
+            this->ys[i] = points[2*i + 1];
+        }
+        this->root = this->build(ids, 0, n_points, 0);
+    }
+    //destructor
+    ~DynamicKDTree()
+    {;}
+
+    //Returns number of points in tree.
+    int n_points() const
+    {
+        return (int)this->xs.size();
+    }
+
+    //Inserts point (x, y). Returns its id.
+    int insert(double x, double y)
+    {
+        int id = this->n_points();
+        std::vector<int>& path = this->path_buffer;
+
+        this->xs.push_back(x);
+        this->ys.push_back(y);
+        this->lefts.push_back(NONE);
+        this->rights.push_back(NONE);
+        this->sizes.push_back(1);
+        this->x_los.push_back(x);
+        this->x_his.push_back(x);
+        this->y_los.push_back(y);
+        this->y_his.push_back(y);
+
+        if(this->root == NONE)
+        {
+            this->root = id;
+            return id;
+        }
+
+        //going down to a leaf, updating subtrees
+        path.clear();
+        for(int node=this->root; node!=NONE;)
+        {
+            path.push_back(node);
+            this->sizes[node]++;
+            this->x_los[node] = std::min(this->x_los[node], x);
+            this->x_his[node] = std::max(this->x_his[node], x);
+            this->y_los[node] = std::min(this->y_los[node], y);
+            this->y_his[node] = std::max(this->y_his[node], y);
+
+            bool left = (path.size() % 2 == 1)?(x < this->xs[node]):
+                (y < this->ys[node]);
+            std::vector<int>& children = left?this->lefts:this->rights;
+            if(children[node] == NONE)
+                children[node] = id;
+            node = children[node] == id?NONE:children[node];
+        }
+
+        //rebuilding highest subtree in path that got too unbalanced
+        for(unsigned depth=0; depth<path.size(); depth++)
+        {
+            int node = path[depth];
+            int left = this->lefts[node], right = this->rights[node];
+            int heavier = std::max(left == NONE?0:this->sizes[left],
+                right == NONE?0:this->sizes[right]);
+
+            if(this->sizes[node] < 8 || 4*heavier <= 3*this->sizes[node])
+                continue;
+
+            std::vector<int>& ids = this->rebuild_buffer;
+            ids.clear();
+            this->collect(node, ids);
+            int subtree = this->build(ids, 0, (int)ids.size(), depth);
+            if(depth == 0)
+                this->root = subtree;
+            else if(this->lefts[path[depth-1]] == node)
+                this->lefts[path[depth-1]] = subtree;
+            else
+                this->rights[path[depth-1]] = subtree;
+            break;
+        }
+
+        return id;
+    }
+
+    //Gets nearest point to (x, y) in each cone around it (NONE if cone has
+    //no points) and their squared distances.
+    void cone_nearest(double x, double y, int* nearest, double* dists) const
+    {
+        for(int i=0; i<N_CONES; i++)
+        {
+            nearest[i] = NONE;
+            dists[i] = std::numeric_limits<double>::infinity();
+        }
+        this->update_cone_nearest(x, y, nearest, dists);
+    }
+
+    //Improves nearest points found so far to (x, y) in each cone, given by
+    //nearest and dists, with points of tree (their ids shifted by id_offset).
+    //Point skip of tree is ignored.
+    void update_cone_nearest(double x, double y, int* nearest, double* dists,
+        int id_offset=0, int skip=NONE) const
+    {
+        if(this->root != NONE)
+            this->_cone_nearest(this->root, x, y, nearest, dists,
+                id_offset, skip);
+    }
+
+    private:
+    int root;
+    //sizes of subtrees
+    std::vector<int> sizes;
+    //nodes from root in last insertion
+    std::vector<int> path_buffer;
+    //nodes of subtree being rebuilt
+    std::vector<int> rebuild_buffer;
+    //coordinates of points
+    std::vector<double> xs;
+    std::vector<double> ys;
+    //children of nodes
+    std::vector<int> lefts;
+    std::vector<int> rights;
+    //bounding boxes of subtrees
+    std::vector<double> x_los;
+    std::vector<double> x_his;
+    std::vector<double> y_los;
+    std::vector<double> y_his;
+
+    //Appends nodes of subtree to ids.
+    void collect(int node, std::vector<int>& ids) const
+    {
+        ids.push_back(node);
+        if(this->lefts[node] != NONE)
+            this->collect(this->lefts[node], ids);
+        if(this->rights[node] != NONE)
+            this->collect(this->rights[node], ids);
+    }
+
+    //Builds balanced subtree at given depth with nodes ids[begin:end],
+    //splitting at medians. Returns its root.
+    int build(std::vector<int>& ids, int begin, int end, int depth)
+    {
+        if(begin >= end)
+            return NONE;
+
+        int mid = begin + (end - begin)/2;
+        if(depth % 2 == 0)
+            std::nth_element(ids.begin() + begin, ids.begin() + mid,
+                ids.begin() + end, CoordLess(this->xs));
+        else
+            std::nth_element(ids.begin() + begin, ids.begin() + mid,
+                ids.begin() + end, CoordLess(this->ys));
+
+        int node = ids[mid];
+        this->lefts[node] = this->build(ids, begin, mid, depth+1);
+        this->rights[node] = this->build(ids, mid+1, end, depth+1);
+
+        this->sizes[node] = end - begin;
+        this->x_los[node] = this->x_his[node] = this->xs[node];
+        this->y_los[node] = this->y_his[node] = this->ys[node];
+        int children[2] = {this->lefts[node], this->rights[node]};
+        for(int i=0; i<2; i++)
+        {
+            if(children[i] == NONE)
+                continue;
+            this->x_los[node] = std::min(this->x_los[node],
+                this->x_los[children[i]]);
+            this->x_his[node] = std::max(this->x_his[node],
+                this->x_his[children[i]]);
+            this->y_los[node] = std::min(this->y_los[node],
+                this->y_los[children[i]]);
+            this->y_his[node] = std::max(this->y_his[node],
+                this->y_his[children[i]]);
+        }
+
+        return node;
+    }
+
+    //Gets bit mask of cones around (x, y) which subtree's box may touch.
+    int cone_mask(int node, double x, double y) const
+    {
+        return box_cone_mask(x, y, this->x_los[node], this->x_his[node],
+            this->y_los[node], this->y_his[node]);
+    }
+
+    //Squared distance from (x, y) to box of subtree.
+    double box_sqr_dist(int node, double x, double y) const
+    {
+        return ::box_sqr_dist(x, y, this->x_los[node], this->x_his[node],
+            this->y_los[node], this->y_his[node]);
+    }
+
+    //cone_nearest auxiliar.
+    void _cone_nearest(int node, double x, double y,
+        int* nearest, double* dists, int id_offset, int skip) const
+    {
+        double box_dist = this->box_sqr_dist(node, x, y);
+        double closest = *std::min_element(dists, dists + N_CONES);
+        double farthest = *std::max_element(dists, dists + N_CONES);
+
+        //box must be close enough for some cone it touches
+        if(box_dist > farthest)
+            return;
+        if(box_dist > closest)
+        {
+            int mask = this->cone_mask(node, x, y);
+            bool useful = false;
+
+            for(int i=0; i<N_CONES; i++)
+                if((mask & (1 << i)) && box_dist <= dists[i])
+                    useful = true;
+            if(!useful)
+                return;
+        }
+
+        double dx = this->xs[node] - x, dy = this->ys[node] - y;
+        double dist = dx*dx + dy*dy;
+        int i = cone(dx, dy);
+        if(dist < dists[i] && node != skip)
+        {
+            dists[i] = dist;
+            nearest[i] = node + id_offset;
+        }
+
+        //visiting closer child first
+        int first = this->lefts[node], second = this->rights[node];
+        if(first == NONE || (second != NONE &&
+            this->box_sqr_dist(second, x, y) < this->box_sqr_dist(first, x, y)))
+            std::swap(first, second);
+        if(first != NONE)
+            this->_cone_nearest(first, x, y, nearest, dists,
+                id_offset, skip);
+        if(second != NONE)
+            this->_cone_nearest(second, x, y, nearest, dists,
+                id_offset, skip);
+    }
+};
+
+/*
+Class representing an euclidean minimum spanning tree kept up to date as
+points are inserted.
+The new point's candidate edges are to its nearest point in each cone;
+each one is added to the tree (kept in a link-cut tree, with edges as nodes
+valued by their costs) and the heaviest edge of the cycle it closes, if
+heavier, is removed. Each insertion takes O(log n) amortized plus the
+cone nearest neighbour queries.
+Quantities of normal and fiber cable are kept along.
+*/
+class IncrementalEMST
+{
+    public:
+    //constructor
+    IncrementalEMST(double fiber_thresh):
+        fiber_thresh(fiber_thresh), normal(0.0), fiber(0.0)
+    {;}
+    //destructor
+    ~IncrementalEMST()
+    {;}
+
+    //Inserts point (x, y). Returns its id.
+    int insert(double x, double y)
+    {
+        int nearest[N_CONES];
+        double dists[N_CONES];
+
+        this->points.cone_nearest(x, y, nearest, dists);
+        int u_id = this->points.insert(x, y);
+        this->vertex_nodes.push_back(this->forest.add_node(
+            -std::numeric_limits<double>::infinity()));
+
+        for(int i=0; i<N_CONES; i++)
+        {
+            if(nearest[i] == NONE)
+                continue;
+
+            int v_id = nearest[i];
+            double cost = distance(x, y, this->xs[v_id], this->ys[v_id]);
+            int u = this->vertex_nodes[u_id];
+            int v = this->vertex_nodes[v_id];
+
+            if(!this->forest.connected(u, v))
+                this->add_edge(u_id, v_id, cost);
+            else
+            {
+                int heaviest = this->forest.path_max(u, v);
+                if(this->forest.get_val(heaviest) > cost)
+                {
+                    this->remove_edge(heaviest);
+                    this->add_edge(u_id, v_id, cost);
+                }
+            }
+        }
+
+        this->xs.push_back(x);
+        this->ys.push_back(y);
+
+        return u_id;
+    }
+
+    //Gets quantity of normal and fiber cable of current tree.
+    double normal_cable() const
+    {
+        return this->normal;
+    }
+    double fiber_cable() const
+    {
+        return this->fiber;
+    }
+
+    //Gets edges of current tree.
+    std::vector<WeightedEdge> edges() const
+    {
+        std::vector<WeightedEdge> edges;
+
+        for(unsigned i=0; i<this->edge_us.size(); i++)
+            if(this->edge_us[i] != NONE)
+                edges.push_back(WeightedEdge(this->edge_us[i],
+                    this->edge_vs[i], this->edge_costs[i]));
+
+        return edges;
+    }
+
+    private:
+    double fiber_thresh;
+    double normal;
+    double fiber;
+    //inserted points
+    DynamicKDTree points;
+    std::vector<double> xs;
+    std::vector<double> ys;
+    //tree, with a node for each vertex and for each edge
+    LinkCutTree forest;
+    //node of each vertex in forest
+    std::vector<int> vertex_nodes;
+    //node in forest, endpoints and cost of each edge slot (NONE if free)
+    std::vector<int> edge_nodes;
+    std::vector<int> edge_us;
+    std::vector<int> edge_vs;
+    std::vector<double> edge_costs;
+    //edge slot of each forest node (NONE for vertices)
+    std::vector<int> node_edges;
+    //free edge slots
+    std::vector<int> free_edges;
+
+    //Adds edge (u, v) to tree.
+    void add_edge(int u_id, int v_id, double cost)
+    {
+        int slot;
+
+        if(this->free_edges.empty())
+        {
+            slot = (int)this->edge_nodes.size();
+            this->edge_nodes.push_back(this->forest.add_node(cost));
+            this->edge_us.push_back(NONE);
+            this->edge_vs.push_back(NONE);
+            this->edge_costs.push_back(0.0);
+        }
+        else
+        {
+            slot = this->free_edges.back();
+            this->free_edges.pop_back();
+            this->forest.set_val(this->edge_nodes[slot], cost);
+        }
+
+        int e = this->edge_nodes[slot];
+        if((int)this->node_edges.size() <= e)
+            this->node_edges.resize(e+1, NONE);
+        this->node_edges[e] = slot;
+        this->edge_us[slot] = u_id;
+        this->edge_vs[slot] = v_id;
+        this->edge_costs[slot] = cost;
+
+        this->forest.link(this->vertex_nodes[u_id], e);
+        this->forest.link(e, this->vertex_nodes[v_id]);
+
+        if(cost > this->fiber_thresh)
+            this->fiber += cost;
+        else
+            this->normal += cost;
+    }
+
+    //Removes edge of node e from tree.
+    void remove_edge(int e)
+    {
+        int slot = this->node_edges[e];
+        double cost = this->edge_costs[slot];
+
+        this->forest.cut(this->vertex_nodes[this->edge_us[slot]], e);
+        this->forest.cut(e, this->vertex_nodes[this->edge_vs[slot]]);
+        this->edge_us[slot] = NONE;
+        this->edge_vs[slot] = NONE;
+        this->free_edges.push_back(slot);
+
+        if(cost > this->fiber_thresh)
+            this->fiber -= cost;
+        else
+            this->normal -= cost;
+    }
+};
+
+//Gets minimum spanning tree of graph, rooted in vertex vtx, by inserting
+//its points one at a time in an incremental euclidean mst.
+//Returns pi, the parents list.
+std::vector<int> incremental_min_spanning_tree(const EuclideanGraph& graph,
+    int vtx_id)
+{
+    IncrementalEMST emst(0.0);
+
+    for(int i=0; i<graph.n_vertices(); i++)
+        emst.insert(graph.get_x(i), graph.get_y(i));
+
+    return tree_parents(graph.n_vertices(), emst.edges(), vtx_id);
+}
+
+/*
+Class representing boruvka over a uniform grid of square cells, with about
+two points per cell, for the euclidean minimum spanning tree.
+In each round, the lightest edge leaving each component is searched from
+each of its points in rings of cells around it, which stops as soon as the
+next ring is farther than the lightest edge found for the component so far.
+Cells with only points of the searching component are skipped, and points
+near other components search first, so for uniformly scattered points each
+round takes O(n) distance evaluations.
+Clustered points crowd some cells and leave large empty regions, which
+make searches quadratic; uniform() tells whether the grid is fit.
+Points are referred to by their position in grid (sorted by cell).
+*/
+class GridBoruvka
+{
+    public:
+    //constructor
+    GridBoruvka(const EuclideanGraph& graph):
+        n_points(graph.n_vertices()), xs(graph.n_vertices()),
+        ys(graph.n_vertices()), ids(graph.n_vertices()),
+        labels(seq(0, graph.n_vertices()-1))
+    {
+        double hi_x, hi_y;
+
+        bounding_box(graph, this->lo_x, hi_x, this->lo_y, hi_y);
+        double width = hi_x - this->lo_x, height = hi_y - this->lo_y;
+
+        //side of cells for about two points per cell (for points on a line,
+        //two points per cell along it)
+        if(width > 0 && height > 0)
+            this->side = sqrt(2*width*height / this->n_points);
+        else
+            this->side = 2*std::max(width, height) / this->n_points;
+        if(!(this->side > 0))
+            this->side = 1.0;
+        //at most about 4 cells per point
+        this->side = std::max(this->side,
+            std::max(width, height) / (4.0*this->n_points));
+        this->n_cols = std::min(4*this->n_points, (int)(width/this->side) + 1);
+        this->n_rows = std::min(4*this->n_points, (int)(height/this->side) + 1);
+        this->slack = 1e-9 * std::max(width, height);
+
+        //sorting points by cell
+        std::vector<int> cells(this->n_points);
+        this->cell_starts.assign(this->n_cells()+1, 0);
+        for(int i=0; i<this->n_points; i++)
+        {
+            cells[i] = this->cell(graph.get_x(i), graph.get_y(i));
+            this->cell_starts[cells[i]+1]++;
+        }
+        for(int c=0; c<this->n_cells(); c++)
+            this->cell_starts[c+1] += this->cell_starts[c];
+        std::vector<int> cursors(this->cell_starts.begin(),
+            this->cell_starts.end()-1);
+        for(int i=0; i<this->n_points; i++)
+        {
+            int p = cursors[cells[i]]++;
+            this->xs[p] = graph.get_x(i);
+            this->ys[p] = graph.get_y(i);
+            this->ids[p] = i;
+        }
+    }
+    //destructor
+    ~GridBoruvka()
+    {;}
+
+    //True if points are spread evenly enough over grid: no cell is much
+    //more crowded than expected and there are few empty cells.
+    bool uniform() const
+    {
+        int n_empty = 0, max_points = 0;
+
+        if(this->n_points < 64)
+            return true;
+
+        for(int c=0; c<this->n_cells(); c++)
+        {
+            int cell_points = this->cell_starts[c+1] - this->cell_starts[c];
+            n_empty += cell_points == 0;
+            max_points = std::max(max_points, cell_points);
+        }
+
+        return max_points <= 32 && 10*n_empty <= 3*this->n_cells();
+    }
+
+    //Gets edges of minimum spanning tree.
+    std::vector<WeightedEdge> edges()
+    {
+        std::vector<WeightedEdge> edges;
+        DisjointSets sets(this->n_points);
+        //lightest edge leaving each component (by label)
+        std::vector<double> comp_costs(this->n_points);
+        std::vector<int> comp_us(this->n_points);
+        std::vector<int> comp_vs(this->n_points);
+
+        while((int)edges.size() < this->n_points-1)
+        {
+            this->label_cells();
+            std::fill(comp_costs.begin(), comp_costs.end(),
+                std::numeric_limits<double>::infinity());
+            std::fill(comp_us.begin(), comp_us.end(), NONE);
+            std::fill(comp_vs.begin(), comp_vs.end(), NONE);
+
+            //points near other components first, for tighter bounds
+            for(int pass=0; pass<2; pass++)
+                for(int p=0; p<this->n_points; p++)
+                {
+                    int l = this->labels[p];
+                    if(this->near_others(p) != (pass == 0))
+                        continue;
+                    this->nearest_foreign(p, &comp_costs[l], &comp_us[l],
+                        &comp_vs[l]);
+                }
+
+            //adding lightest edges to tree
+            for(int l=0; l<this->n_points; l++)
+                if(comp_us[l] != NONE && sets.merge(comp_us[l], comp_vs[l]))
+                    edges.push_back(WeightedEdge(this->ids[comp_us[l]],
+                        this->ids[comp_vs[l]], sqrt(comp_costs[l])));
+            for(int p=0; p<this->n_points; p++)
+                this->labels[p] = sets.find(p);
+        }
+
+        return edges;
+    }
+
+    private:
+    int n_points;
+    //coordinates and original ids of points, sorted by cell
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<int> ids;
+    //component of points
+    std::vector<int> labels;
+    //origin of grid, side of cells and number of columns and rows
+    double lo_x;
+    double lo_y;
+    double side;
+    int n_cols;
+    int n_rows;
+    //lower bound of distances in rings, to cope with rounding
+    double slack;
+    //position of first point of each cell
+    std::vector<int> cell_starts;
+    //component of points of each cell (NONE if more than one)
+    std::vector<int> cell_labels;
+
+    int n_cells() const
+    {
+        return this->n_cols * this->n_rows;
+    }
+
+    //Gets cell of point (x, y).
+    int cell(double x, double y) const
+    {
+        int col = std::min(this->n_cols-1, (int)((x - this->lo_x)/this->side));
+        int row = std::min(this->n_rows-1, (int)((y - this->lo_y)/this->side));
+
+        return row*this->n_cols + col;
+    }
+
+    //Sets components of cells.
+    void label_cells()
+    {
+        this->cell_labels.assign(this->n_cells(), NONE);
+
+        for(int c=0; c<this->n_cells(); c++)
+            for(int p=this->cell_starts[c]; p<this->cell_starts[c+1]; p++)
+            {
+                if(this->labels[p] != this->labels[this->cell_starts[c]])
+                {
+                    this->cell_labels[c] = NONE;
+                    break;
+                }
+                this->cell_labels[c] = this->labels[p];
+            }
+    }
+
+    //True if cell of p or a neighbour one is empty or has points of other
+    //components.
+    bool near_others(int p) const
+    {
+        int c = this->cell(this->xs[p], this->ys[p]);
+        int col = c % this->n_cols, row = c / this->n_cols;
+
+        for(int i=std::max(0, row-1); i<=std::min(this->n_rows-1, row+1); i++)
+            for(int j=std::max(0, col-1); j<=std::min(this->n_cols-1, col+1);
+                j++)
+                if(this->cell_labels[i*this->n_cols + j] != this->labels[p])
+                    return true;
+
+        return false;
+    }
+
+    //Searches rings of cells around p for a point of other component
+    //closer than edge (u, v) with squared cost best_cost, updating it.
+    void nearest_foreign(int p, double* best_cost, int* best_u, int* best_v)
+        const
+    {
+        double x = this->xs[p], y = this->ys[p];
+        int c = this->cell(x, y);
+        int col = c % this->n_cols, row = c / this->n_cols;
+        int label = this->labels[p];
+
+        for(int ring=0; ; ring++)
+        {
+            for(int i=row-ring; i<=row+ring; i++)
+            {
+                if(i < 0 || i >= this->n_rows)
+                    continue;
+                //inner cells of ring's rows were already searched
+                int step = (i == row-ring || i == row+ring)?1:2*ring;
+                for(int j=col-ring; j<=col+ring; j+=std::max(step, 1))
+                {
+                    int d = i*this->n_cols + j;
+                    if(j < 0 || j >= this->n_cols ||
+                        this->cell_starts[d] == this->cell_starts[d+1] ||
+                        this->cell_labels[d] == label)
+                        continue;
+                    if(box_sqr_dist(x, y,
+                        this->lo_x + j*this->side - this->slack,
+                        this->lo_x + (j+1)*this->side + this->slack,
+                        this->lo_y + i*this->side - this->slack,
+                        this->lo_y + (i+1)*this->side + this->slack) >
+                        *best_cost)
+                        continue;
+
+                    for(int q=this->cell_starts[d]; q<this->cell_starts[d+1];
+                        q++)
+                    {
+                        if(this->labels[q] == label)
+                            continue;
+                        double cost = sqr(this->xs[q] - x) +
+                            sqr(this->ys[q] - y);
+                        if(*best_u == NONE || edge_key_less(cost,
+                            this->ids[p], this->ids[q], *best_cost,
+                            this->ids[*best_u], this->ids[*best_v]))
+                        {
+                            *best_cost = cost;
+                            *best_u = p;
+                            *best_v = q;
+                        }
+                    }
+                }
+            }
+
+            //cells beyond ring are at least bound away
+            //(sides of ring at border of grid have no cells beyond)
+            double bound = std::numeric_limits<double>::infinity();
+            if(col-ring > 0)
+                bound = std::min(bound,
+                    x - (this->lo_x + (col-ring)*this->side));
+            if(col+ring < this->n_cols-1)
+                bound = std::min(bound,
+                    this->lo_x + (col+ring+1)*this->side - x);
+            if(row-ring > 0)
+                bound = std::min(bound,
+                    y - (this->lo_y + (row-ring)*this->side));
+            if(row+ring < this->n_rows-1)
+                bound = std::min(bound,
+                    this->lo_y + (row+ring+1)*this->side - y);
+            if(bound == std::numeric_limits<double>::infinity())
+                break;
+            bound = std::max(0.0, bound - this->slack);
+            if(sqr(bound) > *best_cost)
+                break;
+        }
+    }
+};
+
+//Gets minimum spanning tree of graph, rooted in vertex vtx, via boruvka
+//over a uniform grid of its points. If points are not spread evenly, the
+//k-d tree is used instead.
+//Returns pi, the parents list.
+std::vector<int> grid_min_spanning_tree(const EuclideanGraph& graph,
+    int vtx_id, ThreadPool& pool)
+{
+    GridBoruvka boruvka(graph);
+
+    if(!boruvka.uniform())
+        return boruvka_min_spanning_tree(graph, vtx_id, pool);
+
+    return tree_parents(graph.n_vertices(), boruvka.edges(), vtx_id);
+}
+
+//Gets minimum spanning tree of graph rooted in vertex 0 using engine
+//given by options.
+//Returns pi, the parents list.
+std::vector<int> get_mst(const EuclideanGraph& graph, const Options& options)
+{
+    switch(options.engine)
+    {
+        case HEAP_PRIM:
+            switch(options.heap)
+            {
+                case QUATERNARY_HEAP:
+                    return min_spanning_tree<DaryHeap<double, 4> >(graph, 0);
+                case OCTONARY_HEAP:
+                    return min_spanning_tree<DaryHeap<double, 8> >(graph, 0);
+                case PAIRING_HEAP:
+                    return min_spanning_tree<PairingHeap<double> >(graph, 0);
+                case ALIGNED_HEAP:
+                    return min_spanning_tree<AlignedHeap<double> >(graph, 0);
+                default:
+                    return min_spanning_tree<DaryHeap<double, 2> >(graph, 0);
+            }
+        case DELAUNAY:
+            return delaunay_min_spanning_tree(graph, 0);
+        case BORUVKA:
+            return boruvka_min_spanning_tree(graph, 0, *options.pool);
+        case PARALLEL_PRIM:
+            return parallel_min_spanning_tree(graph, 0, *options.pool);
+        case INCREMENTAL:
+            return incremental_min_spanning_tree(graph, 0);
+        case GRID_BORUVKA:
+            return grid_min_spanning_tree(graph, 0, *options.pool);
+        default:
+            switch(options.precision)
+            {
+                case FLOAT_PRECISION:
+                    return dense_min_spanning_tree<FloatPrecision>(graph, 0);
+                case FIXED_PRECISION:
+                    return dense_min_spanning_tree<FixedPrecision>(graph, 0);
+                default:
+                    return dense_min_spanning_tree<DoublePrecision>(graph, 0);
+            }
+    }
+}
+
+//Reads from stdin coordinates values and builds graph.
+//Edge costs are not materialized, so graph takes O(n) memory.
+EuclideanGraph fill_graph(int n_lines)
+{
+    EuclideanGraph graph(n_lines);
+    double x, y;
+
+    //reading coordinates
+    for(int i=0; i<n_lines; i++)
+    {
+        std::cin >> x;
+        std::cin >> y;
+        graph.add_vertex(x, y);
+    }
+
+    return graph;
+}
+
+//Gets quantity of normal and fiber cable to be used from minimum spanning tree.
+void get_dists(const EuclideanGraph& graph, const std::vector<int>& pi,
+        double fiber_thresh, double* normal_cable, double* fiber_cable)
+{
+    *normal_cable = 0.0;
+    *fiber_cable = 0.0;
+
+    for(int i=0; i<(int)pi.size(); i++)
+    {
+        if(pi[i] == NONE)
+            continue;
+
+        double cost = graph.get_edge_cost(pi[i], i);
+
+        if(cost > fiber_thresh)
+            (*fiber_cable) += cost;
+        else
+            (*normal_cable) += cost;
+    }
+}
+
+/*
+Class representing the edge costs of a minimum spanning tree, sorted and
+with prefix sums, to get the quantities of normal and fiber cable for any
+threshold in O(log n).
+*/
+class ThresholdIndex
+{
+    public:
+    //constructor
+    ThresholdIndex(const EuclideanGraph& graph, const std::vector<int>& pi):
+        prefix_sums(1, 0.0)
+    {
+        for(int i=0; i<(int)pi.size(); i++)
+            if(pi[i] != NONE)
+                this->costs.push_back(graph.get_edge_cost(pi[i], i));
+
+        std::sort(this->costs.begin(), this->costs.end());
+        for(unsigned i=0; i<this->costs.size(); i++)
+            this->prefix_sums.push_back(this->prefix_sums[i] + this->costs[i]);
+    }
+    //destructor
+    ~ThresholdIndex()
+    {;}
+
+    //Gets quantity of normal and fiber cable for threshold fiber_thresh.
+    void get_dists(double fiber_thresh,
+        double* normal_cable, double* fiber_cable) const
+    {
+        //edges up to threshold are of normal cable
+        int n_normal = (int)(std::upper_bound(this->costs.begin(),
+            this->costs.end(), fiber_thresh) - this->costs.begin());
+
+        *normal_cable = this->prefix_sums[n_normal];
+        *fiber_cable = this->prefix_sums.back() - *normal_cable;
+    }
+
+    private:
+    //sorted costs of edges
+    std::vector<double> costs;
+    //the ith element has the sum of the i smallest costs
+    std::vector<double> prefix_sums;
+};
+
+//Struct representing a test case: a site to be connected.
+struct TestCase
+{
+    TestCase()
+    {;}
+    ~TestCase()
+    {;}
+
+    //cables longer than a threshold must be of fiber.
+    //each threshold is an independent query over the same points.
+    std::vector<double> fiber_threshs;
+    //points to connect
+    EuclideanGraph graph;
+};
+
+//Struct with quantities of cable of a full connection.
+struct CableCosts
+{
+    CableCosts():
+        normal(0.0), fiber(0.0)
+    {;}
+    ~CableCosts()
+    {;}
+
+    double normal;
+    double fiber;
+};
+
+//Magic number of binary point files.
+#define POINT_FILE_MAGIC "MC3P"
+
+//Header of binary point files, followed by the test cases.
+struct PointFileHeader
+{
+    char magic[4];
+    uint32_t n_cases;
+};
+
+//Header of a test case in binary point files, followed by the x
+//coordinates of its points and then by the y coordinates, each with
+//coord_size bytes.
+struct PointCaseHeader
+{
+    uint64_t n_points;
+    double fiber_thresh;
+    uint32_t coord_size;
+    uint32_t reserved;
+};
+
+/*
+Class representing a file mapped in memory.
+Pages are loaded by the system on demand and may be evicted, so files
+larger than memory can be mapped.
+*/
+class MappedFile
+{
+    public:
+    //constructor. maps size bytes of file open in fd. writable maps are
+    //shared, so changes go to the file.
+    MappedFile(int fd, size_t size, bool writable=false):
+        data(NULL), size(size)
+    {
+        if(size == 0)
+            return;
+
+        void* addr = mmap(NULL, size, PROT_READ | (writable?PROT_WRITE:0),
+            MAP_SHARED, fd, 0);
+        if(addr != MAP_FAILED)
+            this->data = (char*)addr;
+    }
+    //destructor
+    ~MappedFile()
+    {
+        if(this->data != NULL)
+            munmap(this->data, this->size);
+    }
+
+    //True if file was mapped.
+    bool ok() const
+    {
+        return this->size == 0 || this->data != NULL;
+    }
+
+    char* data;
+    size_t size;
+
+    private:
+    //mappings are not copyable
+    MappedFile(const MappedFile& file);
+    MappedFile& operator=(const MappedFile& file);
+};
+
+/*
+Class representing a binary point file, mapped in memory.
+Cases are checked when file is opened. Graphs of cases with double
+coordinates view the mapped arrays (no copies); float coordinates are
+converted.
+*/
+class PointFile
+{
+    public:
+    //constructor
+    PointFile(const std::string& path):
+        file(NULL), valid(false), next(0)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat st;
+
+        if(fd < 0)
+            return;
+        if(fstat(fd, &st) == 0)
+            this->file = new MappedFile(fd, st.st_size);
+        close(fd);
+        if(this->file == NULL || !this->file->ok() ||
+            this->file->size < sizeof(PointFileHeader))
+            return;
+
+        const PointFileHeader* header = (const PointFileHeader*)
+            this->file->data;
+        if(memcmp(header->magic, POINT_FILE_MAGIC, sizeof(header->magic)))
+            return;
+
+        //finding cases
+        size_t offset = sizeof(PointFileHeader);
+        for(uint32_t i=0; i<header->n_cases; i++)
+        {
+            if(offset + sizeof(PointCaseHeader) > this->file->size)
+                return;
+            const PointCaseHeader* case_header =
+                (const PointCaseHeader*)(this->file->data + offset);
+            size_t n_points = case_header->n_points;
+            size_t coord_size = case_header->coord_size;
+
+            if((coord_size != sizeof(double) && coord_size != sizeof(float))
+                || n_points > (size_t)std::numeric_limits<int>::max() ||
+                2*n_points*coord_size > this->file->size - offset -
+                    sizeof(PointCaseHeader))
+                return;
+            this->case_offsets.push_back(offset);
+            offset += sizeof(PointCaseHeader) + 2*n_points*coord_size;
+        }
+        this->valid = true;
+    }
+    //destructor
+    ~PointFile()
+    {
+        delete this->file;
+    }
+
+    //True if file was read and is well formed.
+    bool ok() const
+    {
+        return this->valid;
+    }
+
+    //Returns number of test cases in file.
+    int n_cases() const
+    {
+        return (int)this->case_offsets.size();
+    }
+
+    //Gets header of case i.
+    const PointCaseHeader& case_header(int i) const
+    {
+        return *(const PointCaseHeader*)(this->file->data +
+            this->case_offsets[i]);
+    }
+
+    //Gets x and y coordinates of case i, with coord_size bytes each.
+    const char* case_xs(int i) const
+    {
+        return this->file->data + this->case_offsets[i] +
+            sizeof(PointCaseHeader);
+    }
+    const char* case_ys(int i) const
+    {
+        return this->case_xs(i) +
+            this->case_header(i).n_points*this->case_header(i).coord_size;
+    }
+
+    //Reads next test case.
+    void read_case(TestCase& test_case)
+    {
+        const PointCaseHeader& header = this->case_header(this->next);
+        int n_points = (int)header.n_points;
+
+        test_case.fiber_threshs.assign(1, header.fiber_thresh);
+        if(header.coord_size == sizeof(double))
+            test_case.graph = EuclideanGraph(
+                (const double*)this->case_xs(this->next),
+                (const double*)this->case_ys(this->next), n_points);
+        else
+        {
+            const float* xs = (const float*)this->case_xs(this->next);
+            const float* ys = (const float*)this->case_ys(this->next);
+
+            test_case.graph = EuclideanGraph(n_points);
+            for(int i=0; i<n_points; i++)
+                test_case.graph.add_vertex(xs[i], ys[i]);
+        }
+        this->next++;
+    }
+
+    private:
+    MappedFile* file;
+    bool valid;
+    //offsets of cases in file
+    std::vector<size_t> case_offsets;
+    //next case to be read
+    int next;
+
+    //point files are not copyable
+    PointFile(const PointFile& file);
+    PointFile& operator=(const PointFile& file);
+};
+
+//Reads test case from stdin.
+//If batch, case has the number of thresholds after the number of points,
+//followed by the thresholds.
+void read_case(TestCase& test_case, bool batch)
+{
+    int n_points;
+    int n_threshs = 1;
+
+    std::cin >> n_points;
+    if(batch)
+        std::cin >> n_threshs;
+    test_case.fiber_threshs.resize(n_threshs);
+    for(int i=0; i<n_threshs; i++)
+        std::cin >> test_case.fiber_threshs[i];
+
+    //building graph from coordinates
+    test_case.graph = fill_graph(n_points);
+}
+
+//Reads next test case from binary point file of options, or from stdin.
+void read_case(TestCase& test_case, const Options& options)
+{
+    if(options.points != NULL)
+        options.points->read_case(test_case);
+    else
+        read_case(test_case, options.batch);
+}
+
+//Gets costs of a full connection of minimum cost for the first i points of
+//test case, for each i, with its first threshold.
+std::vector<CableCosts> solve_case_incremental(const TestCase& test_case)
+{
+    const EuclideanGraph& graph = test_case.graph;
+    std::vector<CableCosts> costs(graph.n_vertices());
+    IncrementalEMST emst(test_case.fiber_threshs.empty()?
+        0.0:test_case.fiber_threshs[0]);
+
+    for(int i=0; i<graph.n_vertices(); i++)
+    {
+        emst.insert(graph.get_x(i), graph.get_y(i));
+        costs[i].normal = emst.normal_cable();
+        costs[i].fiber = emst.fiber_cable();
+    }
+
+    return costs;
+}
+
+//Gets costs of a full connection of minimum cost for test case,
+//one for each threshold.
+std::vector<CableCosts> solve_case(const TestCase& test_case,
+    const Options& options)
+{
+    std::vector<CableCosts> costs(test_case.fiber_threshs.size());
+    std::vector<int> pi;
+
+    if(options.incremental)
+        return solve_case_incremental(test_case);
+    if(test_case.graph.n_vertices() < 2)
+        return costs;
+
+    //getting costs for connection
+    pi = get_mst(test_case.graph, options);
+    if(costs.size() == 1)
+    {
+        get_dists(test_case.graph, pi, test_case.fiber_threshs[0],
+            &costs[0].normal, &costs[0].fiber);
+        return costs;
+    }
+
+    ThresholdIndex index(test_case.graph, pi);
+    for(unsigned i=0; i<costs.size(); i++)
+        index.get_dists(test_case.fiber_threshs[i],
+            &costs[i].normal, &costs[i].fiber);
+
+    return costs;
+}
+
+//Prints costs to stdout, one line for each threshold.
+void print_costs(const std::vector<CableCosts>& costs)
+{
+    for(unsigned i=0; i<costs.size(); i++)
+        std::cout << round(costs[i].normal) << " " << round(costs[i].fiber)
+            << std::endl;
+}
+
+//Solves the problem of getting a full connection of minimum cost.
+void min_cost_full_connection(const Options& options)
+{
+    TestCase test_case;
+
+    read_case(test_case, options);
+    print_costs(solve_case(test_case, options));
+}
+
+//Solves the problem for n_test_cases test cases, also in double precision,
+//and prints to stderr the maximum deviation of the rounded costs.
+void verify_full_connection(const Options& options, int n_test_cases)
+{
+    Options exact_options = options;
+    int normal_deviation = 0, fiber_deviation = 0;
+
+    exact_options.precision = DOUBLE_PRECISION;
+
+    for(int i=0; i<n_test_cases; i++)
+    {
+        TestCase test_case;
+
+        read_case(test_case, options);
+        std::vector<CableCosts> costs = solve_case(test_case, options);
+        std::vector<CableCosts> exact_costs = solve_case(test_case,
+            exact_options);
+        print_costs(costs);
+
+        for(unsigned j=0; j<costs.size(); j++)
+        {
+            normal_deviation = std::max(normal_deviation,
+                abs(round(costs[j].normal) - round(exact_costs[j].normal)));
+            fiber_deviation = std::max(fiber_deviation,
+                abs(round(costs[j].fiber) - round(exact_costs[j].fiber)));
+        }
+    }
+
+    std::cerr << "maximum deviation from double precision: "
+        << normal_deviation << " normal, " << fiber_deviation << " fiber"
+        << std::endl;
+}
+
+//Reads n_test_cases test cases (as given by options) and writes them to
+//binary point file in path, with coordinates of coord_size bytes (those of
+//double or of float). Only the first threshold of each case is kept.
+//Returns false on error.
+bool write_point_file(const std::string& path, int n_test_cases,
+    const Options& options, int coord_size)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    PointFileHeader header;
+    bool ok;
+
+    if(file == NULL)
+        return false;
+
+    memcpy(header.magic, POINT_FILE_MAGIC, sizeof(header.magic));
+    header.n_cases = n_test_cases;
+    ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for(int i=0; i<n_test_cases && ok; i++)
+    {
+        TestCase test_case;
+        PointCaseHeader case_header;
+
+        read_case(test_case, options);
+        const EuclideanGraph& graph = test_case.graph;
+        int n_points = graph.n_vertices();
+        std::vector<char> xs(n_points*coord_size), ys(n_points*coord_size);
+        for(int j=0; j<n_points; j++)
+        {
+            if(coord_size == sizeof(float))
+            {
+                ((float*)&xs[0])[j] = (float)graph.get_x(j);
+                ((float*)&ys[0])[j] = (float)graph.get_y(j);
+            }
+            else
+            {
+                ((double*)&xs[0])[j] = graph.get_x(j);
+                ((double*)&ys[0])[j] = graph.get_y(j);
+            }
+        }
+
+        memset(&case_header, 0, sizeof(case_header));
+        case_header.n_points = n_points;
+        case_header.fiber_thresh = test_case.fiber_threshs.empty()?
+            0.0:test_case.fiber_threshs[0];
+        case_header.coord_size = coord_size;
+        ok = fwrite(&case_header, sizeof(case_header), 1, file) == 1 &&
+            (xs.empty() ||
+            (fwrite(&xs[0], 1, xs.size(), file) == xs.size() &&
+            fwrite(&ys[0], 1, ys.size(), file) == ys.size()));
+    }
+
+    return fclose(file) == 0 && ok;
+}
+
+//Creates temporary file in directory dir, already unlinked so that it is
+//removed once closed. Returns its descriptor, or -1 on error.
+int temp_file(const std::string& dir)
+{
+    std::string path = dir + "/lab_3.XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    int fd;
+
+    name.push_back('\0');
+    fd = mkstemp(&name[0]);
+    if(fd >= 0)
+        unlink(&name[0]);
+
+    return fd;
+}
+
+//maximum number of k-d trees of tiles held at once by external mode
+//(a block of 5x5 tiles)
+#define EXTERNAL_MAX_TREES 25
+
+/*
+Class representing a solver of test cases with more points than fit in
+memory, given by coordinates arrays (mapped from a binary point file).
+Points are bucketed into a grid of tiles of about options.tile_size points,
+written tile by tile to a temporary file. Candidate edges of each point are
+to its nearest point in each cone (which include its neighbours in the
+euclidean minimum spanning tree), searched in rings of tiles around it.
+For each tile, only the minimum spanning forest of its internal candidates
+is kept (the others are the heaviest edge of some cycle), along with the
+candidates to other tiles, and these edges are sorted into a run of another
+temporary file. Runs are then merged by an external kruskal.
+Memory holds at most EXTERNAL_MAX_TREES k-d trees of tiles around the
+current one and the disjoint sets of points (8 bytes per point).
+A cone of a point near the border of the points needs no tiles beyond the
+farthest part of the bounding box of the points in it, so rings stop there
+even if the cone is empty.
+*/
+class ExternalEMST
+{
+    public:
+    //constructor. coordinates have coord_size bytes (double or float).
+    ExternalEMST(const char* xs, const char* ys, int coord_size,
+        int n_points, const Options& options):
+        xs(xs), ys(ys), coord_size(coord_size), n_points(n_points),
+        tile_size(options.tile_size), tmp_dir(options.tmp_dir), tiles(NULL),
+        max_rings(0), max_trees(0)
+    {;}
+    //destructor
+    ~ExternalEMST()
+    {
+        this->clear_trees(NONE);
+    }
+
+    //Gets quantities of cable of minimum spanning tree.
+    //Returns false on error with temporary files.
+    bool get_costs(double fiber_thresh, CableCosts& costs)
+    {
+        if(this->n_points < 2)
+            return true;
+
+        this->make_grid();
+
+        //bucketing points into tiles
+        int tile_fd = temp_file(this->tmp_dir);
+        size_t tiles_size = (size_t)this->n_points * 2 * sizeof(double);
+        if(tile_fd < 0 || ftruncate(tile_fd, tiles_size) != 0)
+            return false;
+        MappedFile tile_map(tile_fd, tiles_size, true);
+        close(tile_fd);
+        if(!tile_map.ok())
+            return false;
+        this->tiles = (double*)tile_map.data;
+        this->bucket_points();
+
+        //writing a run of sorted candidate edges for each tile
+        int edge_fd = temp_file(this->tmp_dir);
+        FILE* edge_file = edge_fd < 0?NULL:fdopen(edge_fd, "w+b");
+        if(edge_file == NULL)
+            return false;
+        std::vector<size_t> run_starts(1, 0);
+        bool ok = true;
+        for(int t=0; t<this->n_tiles() && ok; t++)
+        {
+            std::vector<WeightedEdge> edges = this->tile_candidates(t);
+            ok = edges.empty() || fwrite(&edges[0], sizeof(WeightedEdge),
+                edges.size(), edge_file) == edges.size();
+            run_starts.push_back(run_starts.back() + edges.size());
+        }
+        this->clear_trees(NONE);
+        this->tiles = NULL;
+        ok = ok && fflush(edge_file) == 0;
+
+        //merging runs
+        if(ok)
+        {
+            MappedFile runs(edge_fd, run_starts.back()*sizeof(WeightedEdge));
+            ok = runs.ok();
+            if(ok)
+                this->merge_runs((const WeightedEdge*)runs.data, run_starts,
+                    fiber_thresh, costs);
+        }
+        fclose(edge_file);
+
+        return ok;
+    }
+
+    //Gets most rings of tiles searched for a point.
+    int n_max_rings() const
+    {
+        return this->max_rings;
+    }
+
+    //Gets most k-d trees of tiles held at once.
+    int n_max_trees() const
+    {
+        return this->max_trees;
+    }
+
+    private:
+    //coordinates of points
+    const char* xs;
+    const char* ys;
+    int coord_size;
+    int n_points;
+    //expected number of points per tile
+    int tile_size;
+    //directory of temporary files
+    std::string tmp_dir;
+    //number of tiles per row and per column of grid
+    int grid_size;
+    //bounding box of points, origin of tiles
+    double lo_x;
+    double lo_y;
+    double hi_x;
+    double hi_y;
+    //dimensions of tiles
+    double tile_width;
+    double tile_height;
+    //lower bound of distances in rings, to cope with rounding
+    double slack;
+    //position of first point of each tile in tiles
+    std::vector<int> tile_starts;
+    //bounding boxes of points in each tile
+    std::vector<double> tile_x_los;
+    std::vector<double> tile_x_his;
+    std::vector<double> tile_y_los;
+    std::vector<double> tile_y_his;
+    //points, as x0 y0 x1 y1 ..., sorted by tile
+    double* tiles;
+    //k-d trees of tiles in use
+    std::map<int, DynamicKDTree*> trees;
+    //most rings searched for a point and most k-d trees held at once
+    int max_rings;
+    int max_trees;
+
+    int n_tiles() const
+    {
+        return this->grid_size * this->grid_size;
+    }
+
+    //Getters for coordinates of point i.
+    double get_x(int i) const
+    {
+        if(this->coord_size == sizeof(float))
+            return ((const float*)this->xs)[i];
+        return ((const double*)this->xs)[i];
+    }
+    double get_y(int i) const
+    {
+        if(this->coord_size == sizeof(float))
+            return ((const float*)this->ys)[i];
+        return ((const double*)this->ys)[i];
+    }
+
+    //Gets column and row of tile of point (x, y).
+    int col(double x) const
+    {
+        int c = this->tile_width > 0?(int)((x - this->lo_x)/this->tile_width):0;
+        return std::min(c, this->grid_size-1);
+    }
+    int row(double y) const
+    {
+        int r = this->tile_height > 0?
+            (int)((y - this->lo_y)/this->tile_height):0;
+        return std::min(r, this->grid_size-1);
+    }
+
+    //Sets up grid from bounding box of points.
+    void make_grid()
+    {
+        this->lo_x = this->hi_x = this->get_x(0);
+        this->lo_y = this->hi_y = this->get_y(0);
+        for(int i=1; i<this->n_points; i++)
+        {
+            this->lo_x = std::min(this->lo_x, this->get_x(i));
+            this->hi_x = std::max(this->hi_x, this->get_x(i));
+            this->lo_y = std::min(this->lo_y, this->get_y(i));
+            this->hi_y = std::max(this->hi_y, this->get_y(i));
+        }
+
+        this->grid_size = std::max(1,
+            (int)ceil(sqrt((double)this->n_points / this->tile_size)));
+        this->tile_width = (this->hi_x - this->lo_x) / this->grid_size;
+        this->tile_height = (this->hi_y - this->lo_y) / this->grid_size;
+        this->slack = 1e-9 * std::max(this->hi_x - this->lo_x,
+            this->hi_y - this->lo_y);
+    }
+
+    //Writes points into tiles, sorted by tile, and gets tiles' boxes.
+    void bucket_points()
+    {
+        std::vector<int> cursors(this->n_tiles(), 0);
+        double inf = std::numeric_limits<double>::infinity();
+
+        this->tile_x_los.assign(this->n_tiles(), inf);
+        this->tile_x_his.assign(this->n_tiles(), -inf);
+        this->tile_y_los.assign(this->n_tiles(), inf);
+        this->tile_y_his.assign(this->n_tiles(), -inf);
+
+        //counting points of tiles
+        for(int i=0; i<this->n_points; i++)
+        {
+            double x = this->get_x(i), y = this->get_y(i);
+            int t = this->row(y)*this->grid_size + this->col(x);
+
+            cursors[t]++;
+            this->tile_x_los[t] = std::min(this->tile_x_los[t], x);
+            this->tile_x_his[t] = std::max(this->tile_x_his[t], x);
+            this->tile_y_los[t] = std::min(this->tile_y_los[t], y);
+            this->tile_y_his[t] = std::max(this->tile_y_his[t], y);
+        }
+        this->tile_starts.assign(this->n_tiles()+1, 0);
+        for(int t=0; t<this->n_tiles(); t++)
+        {
+            this->tile_starts[t+1] = this->tile_starts[t] + cursors[t];
+            cursors[t] = this->tile_starts[t];
+        }
+
+        for(int i=0; i<this->n_points; i++)
+        {
+            int t = this->row(this->get_y(i))*this->grid_size +
+                this->col(this->get_x(i));
+
+            this->tiles[2*cursors[t]] = this->get_x(i);
+            this->tiles[2*cursors[t] + 1] = this->get_y(i);
+            cursors[t]++;
+        }
+    }
+
+    //Gets k-d tree of tile t, building it if needed.
+    //If EXTERNAL_MAX_TREES trees are held, the one of the tile farthest
+    //from tile home is freed first.
+    const DynamicKDTree& tree(int t, int home)
+    {
+        std::map<int, DynamicKDTree*>::iterator it = this->trees.find(t);
+
+        if(it != this->trees.end())
+            return *it->second;
+
+        if(this->trees.size() >= EXTERNAL_MAX_TREES)
+        {
+            std::map<int, DynamicKDTree*>::iterator farthest;
+            int farthest_ring = -1;
+
+            for(it=this->trees.begin(); it!=this->trees.end(); ++it)
+            {
+                int ring = std::max(
+                    abs(it->first/this->grid_size - home/this->grid_size),
+                    abs(it->first%this->grid_size - home%this->grid_size));
+                if(ring > farthest_ring)
+                {
+                    farthest = it;
+                    farthest_ring = ring;
+                }
+            }
+            delete farthest->second;
+            this->trees.erase(farthest);
+        }
+
+        DynamicKDTree* tree = new DynamicKDTree(
+            this->tiles + 2*this->tile_starts[t],
+            this->tile_starts[t+1] - this->tile_starts[t]);
+        this->trees[t] = tree;
+        this->max_trees = std::max(this->max_trees, (int)this->trees.size());
+
+        return *tree;
+    }
+
+    //Frees k-d trees of tiles not adjacent to tile t (all if t is NONE).
+    void clear_trees(int t)
+    {
+        std::map<int, DynamicKDTree*>::iterator it = this->trees.begin();
+
+        while(it != this->trees.end())
+        {
+            int u = it->first;
+            if(t != NONE &&
+                abs(u/this->grid_size - t/this->grid_size) <= 1 &&
+                abs(u%this->grid_size - t%this->grid_size) <= 1)
+            {
+                ++it;
+                continue;
+            }
+            delete it->second;
+            this->trees.erase(it++);
+        }
+    }
+
+    //Gets distance from (x, y), in bounding box of points, to border of
+    //box along direction of angle.
+    double box_exit(double x, double y, double angle) const
+    {
+        double dx = cos(angle), dy = sin(angle);
+        double exit = std::numeric_limits<double>::infinity();
+
+        if(dx > 0)
+            exit = std::min(exit, (this->hi_x - x)/dx);
+        else if(dx < 0)
+            exit = std::min(exit, (this->lo_x - x)/dx);
+        if(dy > 0)
+            exit = std::min(exit, (this->hi_y - y)/dy);
+        else if(dy < 0)
+            exit = std::min(exit, (this->lo_y - y)/dy);
+
+        return std::max(0.0, exit);
+    }
+
+    //Gets, for each cone around (x, y), the largest distance to a part of
+    //bounding box of points in it: the farthest of the corners in the cone
+    //and of the points where sides of the cone leave the box.
+    void cone_reaches(double x, double y, double* reaches) const
+    {
+        double corners[4][2] = {{this->lo_x, this->lo_y},
+            {this->lo_x, this->hi_y}, {this->hi_x, this->lo_y},
+            {this->hi_x, this->hi_y}};
+
+        for(int i=0; i<N_CONES; i++)
+        {
+            double side = i*(2*PI / N_CONES) - PI + CONE_OFFSET;
+            reaches[i] = std::max(this->box_exit(x, y, side),
+                this->box_exit(x, y, side + 2*PI / N_CONES));
+        }
+        for(int i=0; i<4; i++)
+        {
+            double dx = corners[i][0] - x, dy = corners[i][1] - y;
+            int k = cone(dx, dy);
+            reaches[k] = std::max(reaches[k], sqrt(dx*dx + dy*dy));
+        }
+        for(int i=0; i<N_CONES; i++)
+            reaches[i] += this->slack;
+    }
+
+    //Gets nearest point in each cone around point p (of tile home), in
+    //rings of tiles around its tile.
+    void cone_nearest(int p, int home, int* nearest, double* dists)
+    {
+        double x = this->tiles[2*p], y = this->tiles[2*p + 1];
+        int c = this->col(x), r = this->row(y);
+        double reaches[N_CONES];
+
+        this->cone_reaches(x, y, reaches);
+        for(int i=0; i<N_CONES; i++)
+        {
+            nearest[i] = NONE;
+            dists[i] = std::numeric_limits<double>::infinity();
+        }
+
+        for(int ring=0; ring<this->grid_size; ring++)
+        {
+            this->max_rings = std::max(this->max_rings, ring+1);
+
+            //tiles farther than ring are at least bound away
+            //(sides of rings at border of grid have no tiles beyond)
+            double bound = std::numeric_limits<double>::infinity();
+            if(c-ring > 0)
+                bound = std::min(bound,
+                    x - (this->lo_x + (c-ring)*this->tile_width));
+            if(c+ring < this->grid_size-1)
+                bound = std::min(bound,
+                    this->lo_x + (c+ring+1)*this->tile_width - x);
+            if(r-ring > 0)
+                bound = std::min(bound,
+                    y - (this->lo_y + (r-ring)*this->tile_height));
+            if(r+ring < this->grid_size-1)
+                bound = std::min(bound,
+                    this->lo_y + (r+ring+1)*this->tile_height - y);
+            bound = std::max(0.0, bound - this->slack);
+
+            for(int i=r-ring; i<=r+ring; i++)
+                for(int j=c-ring; j<=c+ring; j++)
+                {
+                    int t = i*this->grid_size + j;
+                    if(i < 0 || i >= this->grid_size || j < 0 ||
+                        j >= this->grid_size ||
+                        (abs(i-r) != ring && abs(j-c) != ring) ||
+                        this->tile_starts[t] == this->tile_starts[t+1])
+                        continue;
+
+                    //tile must be close enough for some cone it touches
+                    double box_dist = box_sqr_dist(x, y, this->tile_x_los[t],
+                        this->tile_x_his[t], this->tile_y_los[t],
+                        this->tile_y_his[t]);
+                    if(box_dist > *std::max_element(dists, dists + N_CONES))
+                        continue;
+                    int mask = box_cone_mask(x, y, this->tile_x_los[t],
+                        this->tile_x_his[t], this->tile_y_los[t],
+                        this->tile_y_his[t]);
+                    bool useful = false;
+                    for(int k=0; k<N_CONES; k++)
+                        if((mask & (1 << k)) && box_dist <= dists[k])
+                            useful = true;
+                    if(!useful)
+                        continue;
+
+                    int start = this->tile_starts[t];
+                    this->tree(t, home).update_cone_nearest(x, y, nearest,
+                        dists, start,
+                        (p >= start && p < this->tile_starts[t+1])?
+                            p - start:NONE);
+                }
+
+            //a cone is done when its nearest point is closer than tiles
+            //beyond ring, or when these are out of its part of the box
+            bool done = true;
+            for(int k=0; k<N_CONES; k++)
+                if(dists[k] > sqr(bound) && reaches[k] > bound)
+                    done = false;
+            if(done)
+                break;
+        }
+    }
+
+    //Gets candidate edges of points of tile t that may be in the minimum
+    //spanning tree, sorted.
+    std::vector<WeightedEdge> tile_candidates(int t)
+    {
+        int start = this->tile_starts[t], end = this->tile_starts[t+1];
+        std::vector<WeightedEdge> internal, edges;
+        int nearest[N_CONES];
+        double dists[N_CONES];
+
+        this->clear_trees(t);
+
+        for(int p=start; p<end; p++)
+        {
+            this->cone_nearest(p, t, nearest, dists);
+            for(int i=0; i<N_CONES; i++)
+            {
+                if(nearest[i] == NONE)
+                    continue;
+                WeightedEdge edge(p, nearest[i], sqrt(dists[i]));
+                if(nearest[i] >= start && nearest[i] < end)
+                {
+                    edge.u_id -= start;
+                    edge.v_id -= start;
+                    internal.push_back(edge);
+                }
+                else
+                    edges.push_back(edge);
+            }
+        }
+
+        //internal candidates out of tile's spanning forest are not in tree
+        internal = kruskal(end - start, internal);
+        for(unsigned i=0; i<internal.size(); i++)
+            edges.push_back(WeightedEdge(internal[i].u_id + start,
+                internal[i].v_id + start, internal[i].cost));
+        std::sort(edges.begin(), edges.end());
+
+        return edges;
+    }
+
+    //Merges sorted runs of edges, given by their starts, via kruskal,
+    //getting quantities of cable of tree.
+    void merge_runs(const WeightedEdge* edges,
+        const std::vector<size_t>& run_starts, double fiber_thresh,
+        CableCosts& costs)
+    {
+        int n_runs = (int)run_starts.size() - 1;
+        std::vector<size_t> cursors(run_starts.begin(), run_starts.end()-1);
+        DaryHeap<double, 4> queue(n_runs);
+        DisjointSets sets(this->n_points);
+        int n_tree_edges = 0;
+
+        for(int i=0; i<n_runs; i++)
+            if(cursors[i] < run_starts[i+1])
+                queue.push(i, edges[cursors[i]].cost);
+
+        while(!queue.empty() && n_tree_edges < this->n_points-1)
+        {
+            int i = queue.pop();
+            const WeightedEdge& edge = edges[cursors[i]++];
+
+            if(cursors[i] < run_starts[i+1])
+                queue.push(i, edges[cursors[i]].cost);
+            if(!sets.merge(edge.u_id, edge.v_id))
+                continue;
+
+            n_tree_edges++;
+            if(edge.cost > fiber_thresh)
+                costs.fiber += edge.cost;
+            else
+                costs.normal += edge.cost;
+        }
+    }
+};
+
+//Solves test cases of binary point file with bounded memory, printing
+//costs of each one. If options.verify, also prints to stderr the most rings
+//of tiles searched for a point and the most k-d trees held at once.
+//Returns false on error.
+bool min_cost_full_connection_external(const PointFile& points,
+    const Options& options)
+{
+    int max_rings = 0, max_trees = 0;
+
+    for(int i=0; i<points.n_cases(); i++)
+    {
+        const PointCaseHeader& header = points.case_header(i);
+        std::vector<CableCosts> costs(1);
+
+        //file is mapped, so coordinates are not copied
+        ExternalEMST emst(points.case_xs(i), points.case_ys(i),
+            header.coord_size, (int)header.n_points, options);
+        if(!emst.get_costs(header.fiber_thresh, costs[0]))
+            return false;
+        print_costs(costs);
+        max_rings = std::max(max_rings, emst.n_max_rings());
+        max_trees = std::max(max_trees, emst.n_max_trees());
+    }
+
+    if(options.verify)
+        std::cerr << "most rings of tiles searched: " << max_rings
+            << ", most k-d trees held: " << max_trees << std::endl;
+
+    return true;
+}
+
+/*
+Class representing a pipeline that solves test cases in parallel.
+The calling thread parses cases into a bounded queue; worker threads solve
+them (each with its own thread pool for parallel engines) and put results in
+a reorder buffer, from which they are printed in input order.
+At most 'capacity' cases are queued, being solved or waiting to be printed.
+*/
+class CasePipeline
+{
+    public:
+    //constructor
+    CasePipeline(const Options& options, int n_jobs):
+        options(options), capacity(4*n_jobs), n_pushed(0), n_printed(0),
+        done(false), threads(n_jobs)
+    {
+        pthread_mutex_init(&this->mutex, NULL);
+        pthread_cond_init(&this->can_push, NULL);
+        pthread_cond_init(&this->can_pop, NULL);
+    }
+    //destructor
+    ~CasePipeline()
+    {
+        pthread_mutex_destroy(&this->mutex);
+        pthread_cond_destroy(&this->can_push);
+        pthread_cond_destroy(&this->can_pop);
+    }
+
+    //Reads, solves and prints n_cases test cases.
+    void run(int n_cases)
+    {
+        for(unsigned i=0; i<this->threads.size(); i++)
+            pthread_create(&this->threads[i], NULL, CasePipeline::worker,
+                this);
+
+        for(int i=0; i<n_cases; i++)
+        {
+            TestCase* test_case = new TestCase();
+            read_case(*test_case, this->options);
+
+            pthread_mutex_lock(&this->mutex);
+            while(this->n_pushed - this->n_printed >= this->capacity)
+                pthread_cond_wait(&this->can_push, &this->mutex);
+            this->queue.push_back(std::make_pair(this->n_pushed++, test_case));
+            pthread_cond_signal(&this->can_pop);
+            pthread_mutex_unlock(&this->mutex);
+        }
+
+        pthread_mutex_lock(&this->mutex);
+        this->done = true;
+        pthread_cond_broadcast(&this->can_pop);
+        pthread_mutex_unlock(&this->mutex);
+
+        for(unsigned i=0; i<this->threads.size(); i++)
+            pthread_join(this->threads[i], NULL);
+    }
+
+    private:
+    //how to solve cases. each worker uses its own pool.
+    Options options;
+    //maximum number of cases in pipeline
+    int capacity;
+    //number of cases read and printed
+    int n_pushed;
+    int n_printed;
+    //true when all cases were read
+    bool done;
+    //workers
+    std::vector<pthread_t> threads;
+    //cases to solve, with their indexes
+    std::deque<std::pair<int, TestCase*> > queue;
+    //solved cases waiting for previous ones to be printed
+    std::map<int, std::vector<CableCosts> > reorder_buffer;
+    pthread_mutex_t mutex;
+    pthread_cond_t can_push;
+    pthread_cond_t can_pop;
+
+    //Worker threads entry point.
+    static void* worker(void* pipeline)
+    {
+        ((CasePipeline*)pipeline)->work();
+
+        return NULL;
+    }
+
+    //Solves cases until there are no more.
+    void work()
+    {
+        ThreadPool pool(this->options.n_threads);
+        Options options = this->options;
+        options.pool = &pool;
+
+        while(true)
+        {
+            pthread_mutex_lock(&this->mutex);
+            while(this->queue.empty() && !this->done)
+                pthread_cond_wait(&this->can_pop, &this->mutex);
+            if(this->queue.empty())
+            {
+                pthread_mutex_unlock(&this->mutex);
+                break;
+            }
+            std::pair<int, TestCase*> item = this->queue.front();
+            this->queue.pop_front();
+            pthread_mutex_unlock(&this->mutex);
+
+            std::vector<CableCosts> costs = solve_case(*item.second, options);
+            delete item.second;
+
+            pthread_mutex_lock(&this->mutex);
+            this->reorder_buffer[item.first] = costs;
+            while(!this->reorder_buffer.empty() &&
+                this->reorder_buffer.begin()->first == this->n_printed)
+            {
+                print_costs(this->reorder_buffer.begin()->second);
+                this->reorder_buffer.erase(this->reorder_buffer.begin());
+                this->n_printed++;
+            }
+            pthread_cond_signal(&this->can_push);
+            pthread_mutex_unlock(&this->mutex);
+        }
+    }
+};
+
+using namespace std;
+
+//usage: lab_3
+//  [--engine=dense|heap|delaunay|boruvka|parallel|incremental|grid]
+//  [--threads=N] [--jobs=N] [--thresholds]
+//  [--heap=binary|4-ary|8-ary|pairing|aligned] [--incremental]
+//  [--external=FILE] [--tile-size=N] [--tmp-dir=DIR] [--points=FILE]
+//  [--write-points=FILE] [--float32] [--precision=double|float|fixed]
+//  [--verify]
+//--engine: minimum spanning tree algorithm. default is dense.
+//--heap: priority queue of heap engine. default is binary.
+//--threads: number of threads of parallel engines. default is 1.
+//--jobs: number of test cases solved at the same time. default is 1.
+//--thresholds: each case is 'n_points n_thresholds threshold...' followed
+//  by the points. one line is printed for each threshold.
+//--incremental: points are inserted one at a time and costs (with first
+//  threshold) are printed after each insertion, one line per point.
+//--external: cases are read from binary point file FILE instead of stdin
+//  and solved with bounded memory, using tiles of about N points
+//  (default is 1048576) and temporary files in DIR (default is /tmp).
+//--points: cases are read from binary point file FILE instead of stdin.
+//--write-points: cases read are written to binary point file FILE (with
+//  first threshold only), with double coordinates or, with --float32, float
+//  ones.
+//--precision: coordinates and costs of dense engine, either double, float
+//  or 32-bit fixed-point (with float costs). default is double.
+//--verify: cases are also solved in double precision and the maximum
+//  deviation of the outputs is printed to stderr. with --external, the most
+//  rings of tiles searched for a point and the most k-d trees held at once
+//  are printed instead.
+int main(int argc, char** argv)
+{
+    int n_test_cases;
+    int n_jobs = 1;
+    Options options;
+    string external_path, points_path, write_path;
+    int coord_size = sizeof(double);
+
+    for(int i=1; i<argc; i++)
+    {
+        string arg = argv[i];
+
+        if(arg == "--engine=dense")
+            options.engine = DENSE_PRIM;
+        else if(arg == "--engine=heap")
+            options.engine = HEAP_PRIM;
+        else if(arg == "--engine=delaunay")
+            options.engine = DELAUNAY;
+        else if(arg == "--engine=boruvka")
+            options.engine = BORUVKA;
+        else if(arg == "--engine=parallel")
+            options.engine = PARALLEL_PRIM;
+        else if(arg == "--engine=incremental")
+            options.engine = INCREMENTAL;
+        else if(arg == "--engine=grid")
+            options.engine = GRID_BORUVKA;
+        else if(arg == "--incremental")
+            options.incremental = true;
+        else if(arg.find("--external=") == 0)
+            external_path = arg.substr(string("--external=").size());
+        else if(arg.find("--tile-size=") == 0 &&
+            atoi(arg.c_str() + string("--tile-size=").size()) > 0)
+            options.tile_size = atoi(arg.c_str() +
+                string("--tile-size=").size());
+        else if(arg.find("--tmp-dir=") == 0)
+            options.tmp_dir = arg.substr(string("--tmp-dir=").size());
+        else if(arg == "--precision=double")
+            options.precision = DOUBLE_PRECISION;
+        else if(arg == "--precision=float")
+            options.precision = FLOAT_PRECISION;
+        else if(arg == "--precision=fixed")
+            options.precision = FIXED_PRECISION;
+        else if(arg == "--verify")
+            options.verify = true;
+        else if(arg.find("--points=") == 0)
+            points_path = arg.substr(string("--points=").size());
+        else if(arg.find("--write-points=") == 0)
+            write_path = arg.substr(string("--write-points=").size());
+        else if(arg == "--float32")
+            coord_size = sizeof(float);
+        else if(arg.find("--threads=") == 0 &&
+            atoi(arg.c_str() + string("--threads=").size()) > 0)
+            options.n_threads = atoi(arg.c_str() +
+                string("--threads=").size());
+        else if(arg.find("--heap=") == 0 &&
+            heap_kind(arg.substr(string("--heap=").size())) >= 0)
+            options.heap = heap_kind(arg.substr(string("--heap=").size()));
+        else if(arg == "--thresholds")
+            options.batch = true;
+        else if(arg.find("--jobs=") == 0 &&
+            atoi(arg.c_str() + string("--jobs=").size()) > 0)
+            n_jobs = atoi(arg.c_str() + string("--jobs=").size());
+        else
+        {
+            cerr << "invalid argument '" << arg << "'" << endl;
+            return 1;
+        }
+    }
+
+    if(!external_path.empty())
+    {
+        PointFile points(external_path);
+
+        if(!points.ok() || !min_cost_full_connection_external(points, options))
+        {
+            cerr << "could not solve cases of '" << external_path << "'"
+                << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if(!points_path.empty())
+    {
+        options.points = new PointFile(points_path);
+        if(!options.points->ok())
+        {
+            cerr << "could not read '" << points_path << "'" << endl;
+            delete options.points;
+            return 1;
+        }
+        n_test_cases = options.points->n_cases();
+    }
+    else
+        cin >> n_test_cases;
+
+    if(!write_path.empty())
+    {
+        bool written = write_point_file(write_path, n_test_cases, options,
+            coord_size);
+
+        delete options.points;
+        if(!written)
+        {
+            cerr << "could not write '" << write_path << "'" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if(options.verify)
+    {
+        ThreadPool pool(options.n_threads);
+        options.pool = &pool;
+        verify_full_connection(options, n_test_cases);
+    }
+    else if(n_jobs > 1)
+    {
+        CasePipeline pipeline(options, n_jobs);
+        pipeline.run(n_test_cases);
+    }
+    else
+    {
+        ThreadPool pool(options.n_threads);
+        options.pool = &pool;
+
+        for(int i=0; i<n_test_cases; i++)
+            min_cost_full_connection(options);
+    }
+
+    delete options.points;
 
     return 0;
 }
@@ -0,0 +1,2 @@
+295276 48652
+198026 116216
@@ -0,0 +1,8 @@
+0 0
+0 0
+21 0
+22 0
+15 0
+0 14
+14 0
+133 96
@@ -0,0 +1,6 @@
+0 0
+0 5
+5 0
+2 0
+0 10
+171 283
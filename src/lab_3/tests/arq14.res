@@ -0,0 +1,5 @@
+0 0
+10 0
+0 10
+4 6
+206 72
@@ -0,0 +1,2 @@
+5652 21387
+0 5
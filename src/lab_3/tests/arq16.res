@@ -0,0 +1,60 @@
+0 172
+0 172
+0 172
+5 166
+172 0
+92 80
+0 158
+0 158
+4 154
+13 145
+158 0
+43 115
+0 259
+0 259
+3 256
+3 256
+259 0
+3 256
+0 197
+0 197
+0 197
+0 197
+197 0
+57 140
+0 152
+0 152
+0 152
+0 152
+152 0
+90 62
+0 226
+0 226
+0 226
+0 226
+226 0
+75 151
+0 186
+0 186
+0 186
+16 171
+186 0
+87 100
+0 207
+0 207
+0 207
+0 207
+207 0
+13 194
+0 192
+0 192
+3 189
+3 189
+192 0
+3 189
+0 246
+0 246
+0 246
+0 246
+246 0
+47 199
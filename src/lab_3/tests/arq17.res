@@ -0,0 +1,200 @@
+0 10175
+96 0
+0 8402
+3 0
+0 119
+0 3811
+3 0
+20 0
+0 536
+0 2384
+0 3
+0 0
+3 0
+0 3
+14 2
+3 0
+3 0
+0 8487
+0 63
+3 0
+0 31
+0 2881
+0 8650
+0 10125
+0 521
+0 4828
+24 0
+56 0
+0 521
+0 10958
+19 0
+3 0
+0 0
+0 11
+3 0
+0 616
+0 56
+0 9623
+3 0
+17 0
+87 0
+0 1502
+119 0
+80 0
+0 4444
+0 7787
+0 26
+24 0
+3 0
+13 4
+3 0
+0 7915
+0 569
+0 617
+20 0
+0 3236
+0 26
+0 22
+0 3424
+0 4516
+2 0
+0 3
+0 3
+0 1675
+3 0
+21 0
+0 617
+3 0
+28 0
+0 22
+0 5150
+3 0
+2 0
+27 0
+3 0
+0 4388
+0 2760
+0 8514
+0 5297
+0 7097
+0 9094
+0 87
+17 0
+21 0
+0 617
+119 0
+3 0
+0 10565
+0 1251
+29 0
+12 2
+0 4207
+3 0
+0 5021
+0 2963
+0 10529
+0 25
+0 3
+0 5173
+0 579
+0 3514
+21 0
+0 2968
+31 0
+0 8399
+3 0
+0 2140
+0 3836
+0 20
+13 0
+0 615
+0 3
+0 4469
+0 2413
+0 3616
+0 4467
+30 0
+0 608
+0 3878
+3 0
+0 604
+3 0
+11 0
+0 42
+0 5486
+0 3259
+0 42
+0 608
+3 0
+0 6256
+15 0
+0 4321
+20 0
+0 7938
+0 8727
+24 0
+0 200
+3 0
+0 76
+0 2236
+0 27
+0 0
+0 602
+0 2
+0 17
+94 0
+0 4867
+0 3
+0 4216
+0 9107
+0 78
+0 0
+0 9025
+24 0
+0 3988
+0 5649
+0 2661
+0 3
+0 3946
+51 0
+0 3750
+0 2752
+0 346
+3 0
+0 1620
+0 3386
+0 614
+0 615
+0 614
+0 9753
+83 0
+0 3
+24 0
+0 563
+30 0
+3 0
+0 604
+0 18
+0 4446
+3 0
+0 7376
+3 0
+17 4
+38 0
+23 0
+0 3545
+0 9179
+0 9875
+0 4592
+0 590
+3 0
+0 610
+0 5340
+14 0
+0 424
+0 4022
+3 0
+3 0
+0 6648
+27 0
@@ -0,0 +1,37 @@
+0 0
+0 13
+0 29
+0 0
+0 15
+0 21
+0 28
+3 25
+3 34
+5 31
+7 29
+12 29
+14 26
+0 0
+1 0
+1 3
+1 20
+1 25
+0 0
+0 14
+0 14
+0 17
+0 0
+0 8
+0 13
+0 20
+0 33
+0 0
+0 0
+0 19
+0 20
+0 33
+1 32
+6 32
+10 29
+14 29
+21 22
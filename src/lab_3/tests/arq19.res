@@ -0,0 +1,20 @@
+0 257
+363 0
+26 383
+216 202
+116 75
+15 363
+0 296
+0 371
+413 0
+51 136
+26 489
+293 0
+96 189
+31 189
+92 185
+133 131
+116 309
+21 331
+7 400
+274 0
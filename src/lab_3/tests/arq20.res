@@ -0,0 +1,20 @@
+1112 0
+1216 0
+1212 42
+5 1274
+975 0
+796 82
+194 1031
+1014 0
+981 0
+1241 0
+998 0
+1092 0
+955 0
+618 584
+1309 0
+1220 0
+940 42
+62 1225
+100 1189
+999 298
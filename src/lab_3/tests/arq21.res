@@ -0,0 +1,3 @@
+323434 22312
+345930 28936
+maximum deviation from double precision: 0 normal, 0 fiber
@@ -0,0 +1,2 @@
+5238 324006
+378051 10499
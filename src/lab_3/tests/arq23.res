@@ -0,0 +1,2 @@
+107985 195738
+26320 300841
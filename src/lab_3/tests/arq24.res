@@ -0,0 +1,2 @@
+28647 180093
+most rings of tiles searched: 4, most k-d trees held: 14
@@ -0,0 +1,2 @@
+44165 18195
+most rings of tiles searched: 29, most k-d trees held: 25
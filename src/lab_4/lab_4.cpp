@@ -4,241 +4,338 @@
 #include <vector>
 #include <iostream>
 #include <list>
+#include <map>
+#include <set>
+#include <queue>
+#include <functional>
+#include <deque>
+#include <algorithm>
 #include <utility>
 #include <limits>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <stdint.h>
+#include <pthread.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include "indexed_heap.h"
+#include "monotone_queue.h"
+#include "thread_pool.h"
 
 //symbol for 'no parent'
 #define NONE (-1)
 //symbol for infinite
 #define INF (std::numeric_limits<int>::max() >> 2)
+//maximum number of buckets of dial queues
+#define DIAL_MAX_BUCKETS (1 << 16)
+//number of distance arrays kept per direction in batch mode
+#define DIST_CACHE_SIZE 16
+//maximum number of buckets of delta-stepping
+#define DELTA_MAX_BUCKETS (1 << 16)
+//maximum number of vertices settled by witness searches of contraction
+#define CH_WITNESS_SETTLED 500
+//number of heaviest edges checked with contraction hierarchy distances
+#define CH_MAX_CHECKS 32
+//first bytes of contraction hierarchy files
+#define CH_FILE_MAGIC "MC4H"
+//version of contraction hierarchy files (after their first bytes)
+#define CH_FILE_VERSION 2
 
-//heap macros
-#define heap_parent(i) ((i+1)/2-1)
-#define heap_left(i) (2*(i+1)-1)
-#define heap_right(i) (2*(i+1))
+//shortest paths engines
+enum
+{
+    //dijkstra with a priority queue
+    DIJKSTRA=0,
+    //delta-stepping with steps split among threads
+    DELTA_STEPPING
+};
+
+//Infinite distance of distances of type dist_type (INF for int).
+//It is a quarter of the largest value, so a sum of two distances and a cost
+//(all of them within [-infinite, infinite]) never overflows.
+template <class dist_type>
+inline dist_type dist_inf()
+{
+    return std::numeric_limits<dist_type>::max() >> 2;
+}
+
+//Gets a + b, saturated at plus or minus infinite distance (for a and b
+//within [-infinite, infinite], as costs are checked to be when read). The
+//minimum and maximum compile to conditional moves, so there are no
+//branches.
+template <class dist_type>
+inline dist_type saturated_add(dist_type a, dist_type b)
+{
+    return std::max(std::min(a + b, dist_inf<dist_type>()),
+        -dist_inf<dist_type>());
+}
+
+//Gets limit within range of distances of type dist_type: limits of
+//infinite or more become the largest finite distance, as paths as heavy as
+//infinite are never in a path within a limit.
+template <class dist_type>
+inline dist_type clamp_limit(int64_t limit)
+{
+    limit = std::min(limit, (int64_t)dist_inf<dist_type>() - 1);
+    limit = std::max(limit, -(int64_t)dist_inf<dist_type>());
+
+    return (dist_type)limit;
+}
+
+//forward declarations
+class ThreadPool;
+class HierarchyQuery;
+
+//Struct with options of how to solve problem.
+struct Options
+{
+    Options():
+        engine(DIJKSTRA),
+        heap(BINARY_HEAP),
+        n_threads(1),
+        pool(NULL),
+        delta(0),
+        batch(false),
+        int64(false),
+        hierarchy(NULL)
+    {;}
+    ~Options()
+    {;}
+
+    //shortest paths engine
+    int engine;
+    //kind of priority queue of dijkstra (a heap or a monotone queue)
+    int heap;
+    //number of threads of each query
+    int n_threads;
+    //pool of n_threads threads of delta-stepping
+    ThreadPool* pool;
+    //bucket width of delta-stepping (0 for one picked from the graph)
+    int delta;
+    //true if each case has a list of queries
+    bool batch;
+    //true if costs and distances are 64-bit integers
+    bool int64;
+    //distance queries on contraction hierarchy of current case (NULL if
+    //there is none)
+    HierarchyQuery* hierarchy;
+};
 
 /*
-Class representing a graph via adjacency lists.
+Class representing connections of a graph in compressed sparse row form.
+Connections of vertex u are positions [starts[u], starts[u+1]) of parallel
+arrays of targets and costs, so each connection comes with its cost.
 Edges may be of any signed numeric type.
 */
 template <class num_type>
-class Graph
+class Adjacency
 {
     public:
-    //constructors
-    Graph()
-    {;}
-    Graph(int n_vertices):
-        vertices(std::vector<std::vector<std::pair<int, num_type> > >
-            (n_vertices, std::vector<std::pair<int, num_type> >()))
+    //constructor
+    Adjacency():
+        starts(1, 0)
     {;}
     //destructor
-    ~Graph()
+    ~Adjacency()
     {;}
 
-    //Returns number of vertices in graph.
+    //Returns number of vertices.
     int n_vertices() const
     {
-        return (int)this->vertices.size();
+        return (int)this->starts.size() - 1;
+    }
+
+    //Returns number of edges.
+    int n_edges() const
+    {
+        return (int)this->targets.size();
     }
 
     //Returns number of connections of vertex u.
     int n_connections(int u_id) const
     {
-        return (int)this->vertices[u_id].size();
+        return this->starts[u_id+1] - this->starts[u_id];
     }
 
-    //Adds edge (u, v) to graph.
-    void add_edge(int u_id, int v_id, num_type cost)
+    //Gets smallest and largest costs of edges (zero if there are none).
+    void cost_range(num_type* min_cost, num_type* max_cost) const
     {
-        this->vertices[u_id].push_back(std::make_pair(v_id, cost));
+        *min_cost = *max_cost = 0;
+        for(unsigned i=0; i<this->costs.size(); i++)
+        {
+            if(i == 0 || this->costs[i] < *min_cost)
+                *min_cost = this->costs[i];
+            if(i == 0 || this->costs[i] > *max_cost)
+                *max_cost = this->costs[i];
+        }
     }
 
-    //Returns true iff edge (u, v) exists in graph.
-    bool has_edge(int u_id, int v_id) const
+    //Gets vertex of jth connection of vertex u.
+    int get_connection(int u_id, int j) const
     {
-        for(unsigned i=0; i<this->vertices[u_id].size(); i++)
-            if(this->vertices[u_id][i].first == v_id)
-                return true;
-
-        return false;
+        return this->targets[this->starts[u_id] + j];
     }
 
-    //Gets cost of edge (u, v).
-    num_type get_edge_cost(int u_id, int v_id) const
+    //Gets cost of jth connection of vertex u.
+    num_type get_connection_cost(int u_id, int j) const
     {
-        //return this->vertices[u_id][v_id].second;
-        for(unsigned i=0; i<this->vertices[u_id].size(); i++)
-            if(this->vertices[u_id][i].first == v_id)
-                return this->vertices[u_id][i].second;
-
-        return 0;
+        return this->costs[this->starts[u_id] + j];
     }
 
-    //Gets cost of edge (u, v).
-    int get_connection(int u_id, int j) const
+    //Arrays of vertices of origin, vertices and costs of all connections,
+    //in order.
+    const std::vector<int>& connection_sources() const
+    {
+        return this->sources;
+    }
+    const std::vector<int>& connection_targets() const
+    {
+        return this->targets;
+    }
+    const std::vector<num_type>& connection_costs() const
     {
-        return this->vertices[u_id][j].first;
+        return this->costs;
     }
 
     private:
-    //list of vertices
-    std::vector<std::vector<std::pair<int, num_type> > > vertices;
-};
+    template <class> friend class Graph;
 
-//Swaps values of x and y.
-void swap(int* x, int* y)
-{
-    int aux = *x;
-    *x = *y;
-    *y = aux;
-}
+    //position of first connection of each vertex (and total at the end)
+    std::vector<int> starts;
+    //vertices of origin, vertices and costs of connections
+    std::vector<int> sources;
+    std::vector<int> targets;
+    std::vector<num_type> costs;
+};
 
 /*
-Class representing minimum priority queue via heap.
+Class representing a directed graph.
+Both the forward adjacency (connections u -> v) and the reverse one
+(connections v -> u of each edge (u, v)) are kept, so searches on the
+transposed graph need no copy.
 */
-class MinHeapByKey
+template <class num_type>
+class Graph
 {
     public:
-    //constructor
-    MinHeapByKey(const std::vector<int>& vals, std::vector<int>& keys):
-        vals(vals), keys(keys), positions(std::vector<int>(keys.size(), 0))
-    {
-        this->build_heap();
-        for(unsigned i=0; i<vals.size(); i++)
-            this->positions[vals[i]] = i;
-    }
-    //destructor
-    ~MinHeapByKey()
+    //constructors
+    Graph()
     {;}
-
-    //Gets key from value.
-    int get_key(int val) const
-    {
-        return this->keys[val];
-    }
-
-    //True if heap is empty.
-    bool empty()
+    //Builds graph with n_vertices vertices and edges (us[i], vs[i]) of
+    //costs edge_costs[i] (connections of each vertex keep their order).
+    //Both adjacencies come from one counting sort of edges by endpoints.
+    Graph(int n_vertices, const std::vector<int>& us,
+        const std::vector<int>& vs, const std::vector<num_type>& edge_costs)
     {
-        return this->vals_size() == 0;
-    }
-
-    //Returns minimum element, removing it from heap and updating it.
-    int pop()
-    {
-        int ret;
-
-        ret = this->vals[0];
-        this->swap(0, this->vals_size()-1);
-        this->vals.pop_back();
-        this->heapify(0);
+        Adjacency<num_type>& fwd = this->forward_adj;
+        Adjacency<num_type>& rev = this->reverse_adj;
+        int n_edges = (int)us.size();
 
-        return ret;
-    }
+        fwd.starts.assign(n_vertices+1, 0);
+        fwd.sources.resize(n_edges);
+        fwd.targets.resize(n_edges);
+        fwd.costs.resize(n_edges);
+        rev.starts.assign(n_vertices+1, 0);
+        rev.sources.resize(n_edges);
+        rev.targets.resize(n_edges);
+        rev.costs.resize(n_edges);
 
-    //Updates pair key, val and updates heap.
-    void update_key(int val, int key_val)
-    {
-        this->keys[val] = key_val;
-        int id = this->positions[val];
-        while(id > 0 && this->compare(id, heap_parent(id)))
+        //counting of out and in degrees
+        for(int i=0; i<n_edges; i++)
         {
-            this->swap(id, heap_parent(id));
-            id = heap_parent(id);
+            fwd.starts[us[i]+1]++;
+            rev.starts[vs[i]+1]++;
+        }
+        for(int u_id=0; u_id<n_vertices; u_id++)
+        {
+            fwd.starts[u_id+1] += fwd.starts[u_id];
+            rev.starts[u_id+1] += rev.starts[u_id];
         }
-    }
 
-    private:
-    //values
-    std::vector<int> vals;
-    //keys of values
-    std::vector<int> keys;
-    //positions of values in vals vector
-    std::vector<int> positions;
+        //placing each edge in both adjacencies
+        std::vector<int> fwd_cursors(fwd.starts.begin(), fwd.starts.end()-1);
+        std::vector<int> rev_cursors(rev.starts.begin(), rev.starts.end()-1);
+        for(int i=0; i<n_edges; i++)
+        {
+            int fwd_pos = fwd_cursors[us[i]]++;
+            int rev_pos = rev_cursors[vs[i]]++;
 
-    //Number of elements in heap.
-    int vals_size()
-    {
-        return (int)this->vals.size();
+            fwd.sources[fwd_pos] = us[i];
+            fwd.targets[fwd_pos] = vs[i];
+            fwd.costs[fwd_pos] = edge_costs[i];
+            rev.sources[rev_pos] = vs[i];
+            rev.targets[rev_pos] = us[i];
+            rev.costs[rev_pos] = edge_costs[i];
+        }
     }
+    //destructor
+    ~Graph()
+    {;}
 
-    //True if key[val[id_1]] < key[val[id_2]].
-    bool compare(int id_1, int id_2)
+    //Returns number of vertices in graph.
+    int n_vertices() const
     {
-        //return cost_greater(this->keys[this->vals[id_2]],
-         //       this->keys[this->vals[id_1]]);
-        return this->keys[this->vals[id_1]] < this->keys[this->vals[id_2]];
+        return this->forward_adj.n_vertices();
     }
 
-    //Swaps val[id_2] with val[id_1], updating its positions.
-    void swap(int id_1, int id_2)
+    //Returns number of edges in graph.
+    int n_edges() const
     {
-        ::swap(&this->positions[this->vals[id_1]],
-            &this->positions[this->vals[id_2]]);
-        ::swap(&this->vals[id_1], &this->vals[id_2]);
+        return this->forward_adj.n_edges();
     }
 
-    //'floats down' value[id] in heap in order to put it at the right place.
-    void heapify(int id)
+    //Connections u -> v of edges (u, v).
+    const Adjacency<num_type>& forward() const
     {
-        int left_id = heap_left(id);
-        int right_id = heap_right(id);
-        int min_id = id;
-
-        if(left_id < this->vals_size() && this->compare(left_id, min_id))
-            min_id = left_id;
-        if(right_id < this->vals_size() && this->compare(right_id, min_id))
-            min_id = right_id;
-
-        if(min_id != id)
-        {
-            this->swap(min_id, id);
-            this->heapify(min_id);
-        }
+        return this->forward_adj;
     }
 
-    //Makes heap.
-    void build_heap()
+    //Connections v -> u of edges (u, v) (the transposed graph).
+    const Adjacency<num_type>& reverse() const
     {
-        for(int i=this->vals_size()/2; i>=0; i--)
-            this->heapify(i);
+        return this->reverse_adj;
     }
-};
-
-//Returns a list of vertex indexes that are still in priority queue.
-std::vector<int> seq(int start, int end)
-{
-    std::vector<int> vec;
-
-    for(int i=start; i<=end; i++)
-        vec.push_back(i);
 
-    return vec;
-}
+    private:
+    Adjacency<num_type> forward_adj;
+    Adjacency<num_type> reverse_adj;
+};
 
 //Auxiliar routine for method dijkstra.
-void relax(const Graph<int>& graph, int u_id, int v_id,
-        std::vector<int>& pi, std::vector<int>& dists,
-        MinHeapByKey& queue)
+//Vertices enter queue when first reached, and leave it for good once
+//settled (so negative costs, which dijkstra does not support, cannot make
+//vertices come back forever).
+//Distances saturate at infinite, so they never overflow.
+template <class dist_type, class heap_type>
+void relax(int u_id, int v_id, dist_type cost,
+        std::vector<int>& pi, std::vector<dist_type>& dists,
+        const std::vector<bool>& settled, heap_type& queue)
 {
-    int dist;
+    dist_type dist;
 
-    dist = queue.get_key(u_id) + graph.get_edge_cost(u_id, v_id);
-    if((dists[v_id] > dist))
+    dist = saturated_add(dists[u_id], cost);
+    if((dists[v_id] > dist) && !settled[v_id])
     {
         pi[v_id] = u_id;
         dists[v_id] = dist;
-        queue.update_key(v_id, dist);
+        if(queue.contains(v_id))
+            queue.update_key(v_id, dist);
+        else
+            queue.push(v_id, dist);
     }
 }
 
 //Struct for dijkstra algorithm return values.
+template <class dist_type>
 struct DijkstraResults
 {
     DijkstraResults()
     {;}
-    DijkstraResults(int root, std::vector<int> pi, std::vector<int> dists):
+    DijkstraResults(int root, std::vector<int> pi,
+        std::vector<dist_type> dists):
         root(root),
         pi(pi),
         dists(dists)
@@ -251,139 +348,1639 @@ struct DijkstraResults
     //parents vector
     std::vector<int> pi;
     //dists vector
-    std::vector<int> dists;
+    std::vector<dist_type> dists;
 };
 
-//Gets shortest paths of graph, starting from vertex root.
+//Gets shortest paths of graph with connections adj, starting from vertex
+//root, using queue, which must be empty and sized for the vertices.
+//Search stops once the distance of the vertex popped exceeds limit: only
+//vertices up to limit away are guaranteed to have exact distances (others
+//have INF or an upper bound greater than limit).
 //Returns a struct with the root, pi (the parents list) and distances.
-DijkstraResults dijkstra(const Graph<int>& graph, int src_id)
+template <class dist_type, class heap_type>
+DijkstraResults<dist_type> dijkstra(const Adjacency<dist_type>& adj,
+    int src_id, heap_type& queue, dist_type limit)
 {
     //the ith element has the father of the ith vertex in path from src_id
     //to vertex i.
-    std::vector<int> pi(graph.n_vertices(), NONE);
+    std::vector<int> pi(adj.n_vertices(), NONE);
     //the ith element has the current smallest distance from vertex src_id
     //to vertex i.
-    std::vector<int> dists(graph.n_vertices(), INF);
+    std::vector<dist_type> dists(adj.n_vertices(), dist_inf<dist_type>());
     //setting root to have cost zero
     dists[src_id] = 0;
-    //priority queue
-    MinHeapByKey queue(seq(0, graph.n_vertices()-1), dists);
+    //the ith element is true once vertex i has left the queue.
+    std::vector<bool> settled(adj.n_vertices(), false);
+    //priority queue, holding vertices reached but not yet settled
+    queue.push(src_id, 0);
 
     while(!queue.empty())
     {
         int u_id = queue.pop();
 
-        for(int i=0; i<graph.n_connections(u_id); i++)
+        if(dists[u_id] > limit)
+            break;
+        settled[u_id] = true;
+
+        for(int i=0; i<adj.n_connections(u_id); i++)
         {
-            int v_id = graph.get_connection(u_id, i);
-            relax(graph, u_id, v_id, pi, dists, queue);
+            relax(u_id, adj.get_connection(u_id, i),
+                adj.get_connection_cost(u_id, i), pi, dists, settled,
+                queue);
         }
     }
 
-    return DijkstraResults(src_id, pi, dists);
+    return DijkstraResults<dist_type>(src_id, pi, dists);
 }
 
-//Returns transposed graph.
-Graph<int> transpose(const Graph<int>& graph)
+//max_edge_w_limited_path auxiliar.
+//Gets heaviest of edges [begin, end) of flat arrays of sources, targets and
+//costs in a path within path_w_limit (or max_edge_w, if it is heavier).
+//Edges with an endpoint at infinite distance (not reached) are in no path,
+//whatever the limit.
+template <class dist_type>
+dist_type max_edge_w_scan(const int* sources, const int* targets,
+    const dist_type* costs, const dist_type* dists, const dist_type* t_dists,
+    int begin, int end, dist_type path_w_limit, dist_type max_edge_w)
 {
-    Graph<int> t_graph(graph.n_vertices());
-    int u_id, v_id, cost;
-
-    for(int i=0; i<graph.n_vertices(); i++)
+    for(int k=begin; k<end; k++)
     {
-        u_id = i;
+        if(dists[sources[k]] >= dist_inf<dist_type>() ||
+            t_dists[targets[k]] >= dist_inf<dist_type>())
+            continue;
 
-        for(int j=0; j<graph.n_connections(u_id); j++)
-        {
-            v_id = graph.get_connection(u_id, j);
-            cost = graph.get_edge_cost(u_id, v_id);
+        dist_type path_w = dists[sources[k]] + costs[k] +
+            t_dists[targets[k]];
 
-            t_graph.add_edge(v_id, u_id, cost);
-        }
+        if(costs[k] > max_edge_w && path_w <= path_w_limit)
+            max_edge_w = costs[k];
     }
 
-    return t_graph;
+    return max_edge_w;
 }
 
 //max_edge_w_limited_path auxiliar.
+//Scans the edges of graph as flat arrays of sources, targets and costs.
+template <class dist_type>
+dist_type _max_edge_w_limited_path(const Graph<dist_type>& graph,
+    dist_type path_w_limit, const std::vector<dist_type>& graph_dists,
+    const std::vector<dist_type>& t_graph_dists)
+{
+    const Adjacency<dist_type>& adj = graph.forward();
+
+    if(graph.n_edges() == 0)
+        return -1;
+
+    return max_edge_w_scan(&adj.connection_sources()[0],
+        &adj.connection_targets()[0], &adj.connection_costs()[0],
+        &graph_dists[0], &t_graph_dists[0], 0, adj.n_edges(), path_w_limit,
+        (dist_type)-1);
+}
+
+//max_edge_w_limited_path auxiliar, for int distances.
+//Gathers distances of endpoints of several edges at a time where
+//AVX2/AVX-512 is available.
 int _max_edge_w_limited_path(const Graph<int>& graph,
     int path_w_limit,
     const std::vector<int>& graph_dists, const std::vector<int>& t_graph_dists)
 {
+    if(graph.n_edges() == 0)
+        return -1;
+
+    const Adjacency<int>& adj = graph.forward();
+    const int* sources = &adj.connection_sources()[0];
+    const int* targets = &adj.connection_targets()[0];
+    const int* costs = &adj.connection_costs()[0];
+    const int* dists = &graph_dists[0];
+    const int* t_dists = &t_graph_dists[0];
+    int n_edges = adj.n_edges();
     int max_edge_w = -1;
+    int k = 0;
+
+#if defined(__AVX512F__)
+    __m512i vinf = _mm512_set1_epi32(INF);
+    __m512i vlimit = _mm512_set1_epi32(path_w_limit);
+    __m512i vmax = _mm512_set1_epi32(max_edge_w);
+    __m512i vzero = _mm512_setzero_si512();
+
+    for(; k+16<=n_edges; k+=16)
+    {
+        __m512i edge_w = _mm512_loadu_si512(costs + k);
+        //(masked gathers avoid a spurious uninitialized warning of gcc)
+        __m512i dist = _mm512_mask_i32gather_epi32(vzero, 0xffff,
+            _mm512_loadu_si512(sources + k), dists, 4);
+        __m512i t_dist = _mm512_mask_i32gather_epi32(vzero, 0xffff,
+            _mm512_loadu_si512(targets + k), t_dists, 4);
+        __m512i path_w = _mm512_add_epi32(_mm512_add_epi32(dist, edge_w),
+            t_dist);
+        __mmask16 in_path = _mm512_cmplt_epi32_mask(dist, vinf) &
+            _mm512_cmplt_epi32_mask(t_dist, vinf) &
+            _mm512_cmple_epi32_mask(path_w, vlimit);
+
+        vmax = _mm512_mask_max_epi32(vmax, in_path, vmax, edge_w);
+    }
+
+    int32_t lane_max[16];
+    _mm512_storeu_si512(lane_max, vmax);
+    for(int i=0; i<16; i++)
+        if(lane_max[i] > max_edge_w)
+            max_edge_w = lane_max[i];
+#elif defined(__AVX2__)
+    __m256i vinf = _mm256_set1_epi32(INF);
+    __m256i vlimit = _mm256_set1_epi32(path_w_limit);
+    __m256i vnone = _mm256_set1_epi32(max_edge_w);
+    __m256i vmax = vnone;
+
+    for(; k+8<=n_edges; k+=8)
+    {
+        __m256i edge_w = _mm256_loadu_si256((const __m256i*)(costs + k));
+        __m256i dist = _mm256_i32gather_epi32(dists,
+            _mm256_loadu_si256((const __m256i*)(sources + k)), 4);
+        __m256i t_dist = _mm256_i32gather_epi32(t_dists,
+            _mm256_loadu_si256((const __m256i*)(targets + k)), 4);
+        __m256i path_w = _mm256_add_epi32(_mm256_add_epi32(dist, edge_w),
+            t_dist);
+        __m256i in_path = _mm256_andnot_si256(
+            _mm256_cmpgt_epi32(path_w, vlimit),
+            _mm256_and_si256(_mm256_cmpgt_epi32(vinf, dist),
+                _mm256_cmpgt_epi32(vinf, t_dist)));
+
+        vmax = _mm256_max_epi32(vmax,
+            _mm256_blendv_epi8(vnone, edge_w, in_path));
+    }
+
+    int32_t lane_max[8];
+    _mm256_storeu_si256((__m256i*)lane_max, vmax);
+    for(int i=0; i<8; i++)
+        if(lane_max[i] > max_edge_w)
+            max_edge_w = lane_max[i];
+#endif
+
+    //scalar loop (also remainder of vectorized loops)
+    return max_edge_w_scan(sources, targets, costs, dists, t_dists, k,
+        n_edges, path_w_limit, max_edge_w);
+}
+
+//Gets shortest paths of graph with connections adj from vertex root, up to
+//limit, with priority queue of kind heap (one of the kinds in
+//indexed_heap.h or monotone_queue.h).
+//Monotone queues need non-negative costs: with negative ones, a binary heap
+//is used instead (and the whole graph is searched). Dial queues need one
+//bucket per cost, so above DIAL_MAX_BUCKETS costs a radix heap is used
+//instead.
+template <class dist_type>
+DijkstraResults<dist_type> dijkstra(const Adjacency<dist_type>& adj,
+    int src_id, int heap, dist_type limit)
+{
+    int n = adj.n_vertices();
+    dist_type min_cost, max_cost;
+
+    adj.cost_range(&min_cost, &max_cost);
+    if(min_cost < 0)
+    {
+        limit = dist_inf<dist_type>();
+        if(heap == RADIX_HEAP || heap == DIAL_QUEUE)
+            heap = BINARY_HEAP;
+    }
+    else if(heap == DIAL_QUEUE && max_cost >= DIAL_MAX_BUCKETS)
+        heap = RADIX_HEAP;
+
+    switch(heap)
+    {
+        case QUATERNARY_HEAP:
+        {
+            DaryHeap<dist_type, 4> queue(n);
+            return dijkstra(adj, src_id, queue, limit);
+        }
+        case OCTONARY_HEAP:
+        {
+            DaryHeap<dist_type, 8> queue(n);
+            return dijkstra(adj, src_id, queue, limit);
+        }
+        case PAIRING_HEAP:
+        {
+            PairingHeap<dist_type> queue(n);
+            return dijkstra(adj, src_id, queue, limit);
+        }
+        case ALIGNED_HEAP:
+        {
+            AlignedHeap<dist_type, 8> queue(n);
+            return dijkstra(adj, src_id, queue, limit);
+        }
+        case RADIX_HEAP:
+        {
+            RadixHeap<dist_type> queue(n);
+            return dijkstra(adj, src_id, queue, limit);
+        }
+        case DIAL_QUEUE:
+        {
+            DialQueue<dist_type> queue(n, (int)max_cost + 1);
+            return dijkstra(adj, src_id, queue, limit);
+        }
+        default:
+        {
+            DaryHeap<dist_type, 2> queue(n);
+            return dijkstra(adj, src_id, queue, limit);
+        }
+    }
+}
+
+/*
+Class representing a delta-stepping search, run on all threads of a pool.
+Vertices wait in buckets of width delta by distance. The lightest bucket is
+emptied in rounds relaxing its light edges (cost up to delta), which may
+put vertices back in it, and then the heavy edges of the vertices removed
+from it are relaxed once. Buckets are a circular array per thread, with
+enough buckets for the largest cost, and the indexes of non-empty ones are
+kept in a set. Distance and parent of each vertex are packed in a 64-bit
+word, updated by compare-and-swap.
+*/
+class DeltaStepping: public ParallelTask
+{
+    public:
+    //constructor
+    DeltaStepping(const Adjacency<int>& adj, int src_id, int delta,
+        int limit, ThreadPool& pool):
+        adj(adj), delta(delta), limit(limit), pool(pool),
+        states(adj.n_vertices(), pack(INF, NONE)),
+        buckets(pool.n_threads()), filled(pool.n_threads()),
+        removed(pool.n_threads()), current(0), done(false)
+    {
+        int min_cost, max_cost;
+
+        adj.cost_range(&min_cost, &max_cost);
+        this->n_buckets = max_cost/delta + 2;
+        for(int i=0; i<pool.n_threads(); i++)
+            this->buckets[i].resize(this->n_buckets);
+
+        this->states[src_id] = pack(0, NONE);
+        this->buckets[0][0].push_back(src_id);
+    }
+    //destructor
+    ~DeltaStepping()
+    {;}
 
-    for(int i=0; i<graph.n_vertices(); i++)
+    //Runs search on thread thread_id.
+    void run(int thread_id, int n_threads)
     {
-        int u_id = i;
+        std::vector<int>& removed = this->removed[thread_id];
+        int begin, end;
 
-        for(int j=0; j<graph.n_connections(u_id); j++)
+        while(!this->done)
         {
-            int v_id = graph.get_connection(u_id, j);
-            int edge_w = graph.get_edge_cost(u_id, v_id);
-            int path_w = graph_dists[u_id] + edge_w + t_graph_dists[v_id];
+            //rounds over light edges of current bucket
+            while(true)
+            {
+                if(this->pool.barrier())
+                    this->gather_current();
+                this->pool.barrier();
+                if(this->frontier.empty())
+                    break;
+
+                thread_range((int)this->frontier.size(), thread_id, n_threads,
+                    &begin, &end);
+                for(int i=begin; i<end; i++)
+                {
+                    int u_id = this->frontier[i];
+                    int dist = this->dist(u_id);
+
+                    //vertex moved to a lighter bucket and was already handled
+                    if(dist/this->delta != this->current)
+                        continue;
+                    removed.push_back(u_id);
+                    this->relax_edges(thread_id, u_id, dist, true);
+                }
+            }
 
-            if(edge_w > max_edge_w && path_w <= path_w_limit)
-                max_edge_w = edge_w;
+            //heavy edges of vertices removed from current bucket
+            for(unsigned i=0; i<removed.size(); i++)
+                this->relax_edges(thread_id, removed[i],
+                    this->dist(removed[i]), false);
+            removed.clear();
+
+            if(this->pool.barrier())
+                this->next_bucket();
+            this->pool.barrier();
         }
     }
 
-    return max_edge_w;
+    //Gets results of search (which must have been run).
+    DijkstraResults<int> results(int src_id) const
+    {
+        std::vector<int> pi(this->states.size()), dists(this->states.size());
+
+        for(unsigned i=0; i<this->states.size(); i++)
+        {
+            dists[i] = (int)(this->states[i] >> 32);
+            pi[i] = (int)(uint32_t)this->states[i];
+        }
+
+        return DijkstraResults<int>(src_id, pi, dists);
+    }
+
+    private:
+    const Adjacency<int>& adj;
+    int delta;
+    //distance up to which search goes
+    int limit;
+    ThreadPool& pool;
+    //distance (high bits) and parent (low bits) of each vertex
+    std::vector<uint64_t> states;
+    //circular array of buckets of each thread
+    std::vector<std::vector<std::vector<int> > > buckets;
+    int n_buckets;
+    //indexes of buckets that each thread made non-empty since last step
+    std::vector<std::vector<int> > filled;
+    //indexes of buckets that may be non-empty
+    std::set<int> pending;
+    //vertices removed from current bucket by each thread
+    std::vector<std::vector<int> > removed;
+    //vertices of current bucket in a round
+    std::vector<int> frontier;
+    //index of current bucket (distance over delta)
+    int current;
+    //true when search is over
+    bool done;
+
+    //Packs distance and parent in a state.
+    static uint64_t pack(int dist, int parent)
+    {
+        return ((uint64_t)dist << 32) | (uint32_t)parent;
+    }
+
+    //Gets current distance of vertex.
+    int dist(int u_id) const
+    {
+        return (int)(*(volatile const uint64_t*)&this->states[u_id] >> 32);
+    }
+
+    //Relaxes light (or heavy) edges of u, which is dist away from root.
+    void relax_edges(int thread_id, int u_id, int dist, bool light)
+    {
+        for(int j=0; j<this->adj.n_connections(u_id); j++)
+        {
+            int cost = this->adj.get_connection_cost(u_id, j);
+
+            if((cost <= this->delta) == light)
+                this->relax(thread_id, u_id, this->adj.get_connection(u_id, j),
+                    saturated_add(dist, cost));
+        }
+    }
+
+    //Lowers distance of v to dist through u, if it is shorter.
+    //Infinite distances (saturated sums) have no bucket and are ignored.
+    void relax(int thread_id, int u_id, int v_id, int dist)
+    {
+        uint64_t* state = &this->states[v_id];
+        uint64_t old_state = *(volatile uint64_t*)state;
+
+        if(dist >= INF)
+            return;
+        while((int)(old_state >> 32) > dist)
+        {
+            if(__sync_bool_compare_and_swap(state, old_state,
+                pack(dist, u_id)))
+            {
+                std::vector<int>& bucket = this->buckets[thread_id][
+                    (dist/this->delta) % this->n_buckets];
+
+                if(bucket.empty())
+                    this->filled[thread_id].push_back(dist/this->delta);
+                bucket.push_back(v_id);
+                return;
+            }
+            old_state = *(volatile uint64_t*)state;
+        }
+    }
+
+    //Moves vertices in current bucket of all threads to frontier.
+    void gather_current()
+    {
+        int bucket_id = this->current % this->n_buckets;
+
+        this->frontier.clear();
+        for(unsigned i=0; i<this->buckets.size(); i++)
+        {
+            std::vector<int>& bucket = this->buckets[i][bucket_id];
+
+            this->frontier.insert(this->frontier.end(), bucket.begin(),
+                bucket.end());
+            bucket.clear();
+        }
+    }
+
+    //Moves to next non-empty bucket, finishing search if there is none or
+    //it is beyond limit.
+    void next_bucket()
+    {
+        for(unsigned i=0; i<this->filled.size(); i++)
+        {
+            this->pending.insert(this->filled[i].begin(),
+                this->filled[i].end());
+            this->filled[i].clear();
+        }
+        //buckets up to current are empty by now
+        this->pending.erase(this->pending.begin(),
+            this->pending.upper_bound(this->current));
+
+        if(this->pending.empty())
+        {
+            this->done = true;
+            return;
+        }
+        this->current = *this->pending.begin();
+        this->pending.erase(this->pending.begin());
+        this->done = (int64_t)this->current*this->delta > this->limit;
+    }
+};
+
+//Gets a bucket width for delta-stepping on graph with connections adj:
+//largest cost over mean degree (so a vertex has about one light edge per
+//unit of degree), kept within DELTA_MAX_BUCKETS buckets.
+int default_delta(const Adjacency<int>& adj)
+{
+    int min_cost, max_cost;
+    int mean_degree = std::max(1, adj.n_edges() /
+        std::max(1, adj.n_vertices()));
+
+    adj.cost_range(&min_cost, &max_cost);
+
+    return std::max(std::max(1, max_cost/mean_degree),
+        max_cost/(DELTA_MAX_BUCKETS - 2) + 1);
 }
 
-//Returns heaviest edge in a path from src to dst vertices not exceding
-//limit weight.
-int max_edge_w_limited_path(const Graph<int>& graph,
-    int src_id, int dst_id, int path_w_limit)
+//Gets shortest paths of graph with connections adj from vertex root, up to
+//limit, with delta-stepping over threads of pool (with bucket width delta,
+//or one picked from the graph if it is 0).
+//Delta-stepping needs non-negative costs: with negative ones, dijkstra with
+//a binary heap is used instead.
+DijkstraResults<int> delta_stepping(const Adjacency<int>& adj, int src_id,
+    int delta, ThreadPool& pool, int limit=INF)
 {
-    //transposed graph
-    Graph<int> t_graph = transpose(graph);
-    //shortest paths of graph and transposed graph
-    DijkstraResults res = dijkstra(graph, src_id);
-    DijkstraResults t_res = dijkstra(t_graph, dst_id);
+    int min_cost, max_cost;
 
-    return _max_edge_w_limited_path(graph, path_w_limit,
-        res.dists, t_res.dists);
+    adj.cost_range(&min_cost, &max_cost);
+    if(min_cost < 0)
+        return dijkstra(adj, src_id, BINARY_HEAP, limit);
+    if(delta <= 0)
+        delta = default_delta(adj);
+    delta = std::max(delta, max_cost/(DELTA_MAX_BUCKETS - 2) + 1);
+
+    DeltaStepping search(adj, src_id, delta, limit, pool);
+    pool.run(search);
+
+    return search.results(src_id);
 }
 
-//Reads values from stdin and builds graph.
-Graph<int> fill_graph(int n_vertices, int n_edges)
+//Gets shortest paths of graph with connections adj from vertex root, up to
+//limit, with engine of options.
+//Only dijkstra handles distances other than int: for them, it is the one
+//used.
+template <class dist_type>
+DijkstraResults<dist_type> shortest_paths(const Adjacency<dist_type>& adj,
+    int src_id, dist_type limit, const Options& options)
 {
-    Graph<int> graph(n_vertices);
-    int u_id, v_id, cost;
+    return dijkstra(adj, src_id, options.heap, limit);
+}
+DijkstraResults<int> shortest_paths(const Adjacency<int>& adj, int src_id,
+    int limit, const Options& options)
+{
+    if(options.engine == DELTA_STEPPING)
+        return delta_stepping(adj, src_id, options.delta, *options.pool,
+            limit);
 
-    for(int i=0; i<n_edges; i++)
+    return dijkstra(adj, src_id, options.heap, limit);
+}
+
+//Struct describing a shortest paths search, possibly run on its own thread.
+template <class dist_type>
+struct DijkstraSearch
+{
+    //connections followed by search
+    const Adjacency<dist_type>* adj;
+    //root of search
+    int src_id;
+    //engine and priority queue of search
+    const Options* options;
+    //distance up to which search goes
+    dist_type limit;
+    //results of search (owned by the thread running it)
+    DijkstraResults<dist_type> res;
+};
+
+//Runs a search given as a DijkstraSearch (pthread_create compatible).
+template <class dist_type>
+void* run_dijkstra_search(void* search_ptr)
+{
+    DijkstraSearch<dist_type>* search =
+        (DijkstraSearch<dist_type>*)search_ptr;
+
+    search->res = shortest_paths(*search->adj, search->src_id, search->limit,
+        *search->options);
+
+    return NULL;
+}
+
+//Runs searches (either may be NULL). With more than one thread, both run
+//at the same time (except with delta-stepping, where each search uses all
+//of them).
+template <class dist_type>
+void run_dijkstra_searches(DijkstraSearch<dist_type>* search,
+    DijkstraSearch<dist_type>* t_search, const Options& options)
+{
+    pthread_t t_thread;
+
+    if(search != NULL && t_search != NULL && options.n_threads > 1 &&
+        options.engine == DIJKSTRA && pthread_create(&t_thread, NULL,
+        run_dijkstra_search<dist_type>, t_search) == 0)
     {
-        std::cin >> u_id;
-        std::cin >> v_id;
-        std::cin >> cost;
-        graph.add_edge(u_id, v_id, cost);
+        run_dijkstra_search<dist_type>(search);
+        pthread_join(t_thread, NULL);
+        return;
     }
 
-    return graph;
+    if(search != NULL)
+        run_dijkstra_search<dist_type>(search);
+    if(t_search != NULL)
+        run_dijkstra_search<dist_type>(t_search);
 }
 
-using namespace std;
-
-int main()
+/*
+Class representing a contraction hierarchy of a graph.
+Vertices are contracted one at a time, the ones of smallest edge difference
+(shortcuts needed minus connections removed, plus neighbours already
+contracted) first. A shortcut (u, w) replaces path u -> v -> w through a
+contracted vertex v whenever no other path among the remaining vertices is
+as short (witness searches are bounded, so some shortcuts are superfluous).
+The overlay graph has the edges and the shortcuts, and vertices are ranked
+by contraction order: every shortest path has a shortest path of the
+overlay going up and then down in rank.
+*/
+class ContractionHierarchy
 {
-    int n_test_cases;
-    int n_vertices, n_edges, src_id, dst_id, points_limit;
-    int best;
+    public:
+    //constructors
+    ContractionHierarchy():
+        n_graph_edges(0), graph_checksum(0), valid(false)
+    {;}
+    //Builds hierarchy of graph (an invalid one if it has negative costs).
+    ContractionHierarchy(const Graph<int>& graph);
+    //destructor
+    ~ContractionHierarchy()
+    {;}
 
-    cin >> n_test_cases;
-    for(int i=0; i<n_test_cases; i++)
+    //Returns number of vertices.
+    int n_vertices() const
     {
-        cin >> n_vertices;
-        cin >> n_edges;
-        cin >> src_id;
-        cin >> dst_id;
-        cin >> points_limit;
+        return (int)this->ranks.size();
+    }
+
+    //Returns number of edges of graph of hierarchy.
+    int n_edges() const
+    {
+        return this->n_graph_edges;
+    }
 
-        Graph<int> graph = fill_graph(n_vertices, n_edges);
+    //False if graph could not be contracted.
+    bool is_valid() const
+    {
+        return this->valid;
+    }
+
+    //Gets rank of vertex u (position in contraction order).
+    int rank(int u_id) const
+    {
+        return this->ranks[u_id];
+    }
 
-        best = max_edge_w_limited_path(graph, src_id, dst_id, points_limit);
-        cout << best << endl;
+    //Graph of edges and shortcuts.
+    const Graph<int>& overlay() const
+    {
+        return this->overlay_graph;
     }
 
+    //Writes hierarchy to file. Returns false on failure.
+    bool write(FILE* file) const;
+    //Reads hierarchy of graph from file. Returns false on failure or if
+    //hierarchy is malformed or was not built from graph.
+    bool read(FILE* file, const Graph<int>& graph);
+
+    private:
+    //Gets checksum of (u, v, cost) of edges of graph.
+    static uint64_t checksum(const Graph<int>& graph);
+    //True iff ranks are a permutation of vertices and shortcuts are valid.
+    bool well_formed() const;
+
+    //number of edges of graph
+    int n_graph_edges;
+    //checksum of graph
+    uint64_t graph_checksum;
+    //false if graph could not be contracted
+    bool valid;
+    //rank of each vertex
+    std::vector<int> ranks;
+    //edges and shortcuts (as given to overlay_graph)
+    std::vector<int> us, vs, costs;
+    Graph<int> overlay_graph;
+};
+
+/*
+Class representing the contraction of a graph into a hierarchy.
+Connections of the remaining graph are kept as lists of (vertex, cost)
+pairs, with at most one connection per pair of vertices (the cheapest).
+A contracted vertex leaves the lists of its neighbours, and keeps in its own
+lists its connections to vertices contracted after it, which are the edges
+of the hierarchy.
+*/
+class HierarchyBuilder
+{
+    public:
+    //constructor
+    HierarchyBuilder(const Graph<int>& graph):
+        out(graph.n_vertices()), in(graph.n_vertices()),
+        contracted(graph.n_vertices(), false),
+        n_contracted_neighbours(graph.n_vertices(), 0),
+        dists(graph.n_vertices(), INF)
+    {
+        const Adjacency<int>& adj = graph.forward();
+
+        for(int u_id=0; u_id<graph.n_vertices(); u_id++)
+            for(int j=0; j<adj.n_connections(u_id); j++)
+                this->add_edge(u_id, adj.get_connection(u_id, j),
+                    adj.get_connection_cost(u_id, j));
+    }
+    //destructor
+    ~HierarchyBuilder()
+    {;}
+
+    //Contracts all vertices, putting their ranks in ranks and edges and
+    //shortcuts in (us[i], vs[i]) of cost costs[i].
+    void build(std::vector<int>& ranks, std::vector<int>& us,
+        std::vector<int>& vs, std::vector<int>& costs)
+    {
+        //vertices by priority (with stale entries, skipped)
+        std::priority_queue<std::pair<int, int>,
+            std::vector<std::pair<int, int> >,
+            std::greater<std::pair<int, int> > > queue;
+        int n_ranked = 0;
+
+        ranks.assign(this->out.size(), NONE);
+        for(int v_id=0; v_id<(int)this->out.size(); v_id++)
+            queue.push(std::make_pair(this->priority(v_id), v_id));
+
+        while(!queue.empty())
+        {
+            int v_id = queue.top().second;
+
+            queue.pop();
+            if(this->contracted[v_id])
+                continue;
+
+            //priority may have grown since vertex was queued
+            int priority = this->priority(v_id);
+            if(!queue.empty() && priority > queue.top().first)
+            {
+                queue.push(std::make_pair(priority, v_id));
+                continue;
+            }
+
+            this->contract(v_id, false);
+            this->remove_vertex(v_id);
+            ranks[v_id] = n_ranked++;
+
+            //priorities of neighbours are updated lazily, when popped
+            for(unsigned j=0; j<this->out[v_id].size(); j++)
+                this->n_contracted_neighbours[this->out[v_id][j].first]++;
+            for(unsigned j=0; j<this->in[v_id].size(); j++)
+                this->n_contracted_neighbours[this->in[v_id][j].first]++;
+        }
+
+        us.clear();
+        vs.clear();
+        costs.clear();
+        for(int u_id=0; u_id<(int)this->out.size(); u_id++)
+        {
+            for(unsigned j=0; j<this->out[u_id].size(); j++)
+            {
+                us.push_back(u_id);
+                vs.push_back(this->out[u_id][j].first);
+                costs.push_back(this->out[u_id][j].second);
+            }
+            for(unsigned j=0; j<this->in[u_id].size(); j++)
+            {
+                us.push_back(this->in[u_id][j].first);
+                vs.push_back(u_id);
+                costs.push_back(this->in[u_id][j].second);
+            }
+        }
+    }
+
+    private:
+    //connections (vertex, cost) from and to each vertex
+    std::vector<std::vector<std::pair<int, int> > > out;
+    std::vector<std::vector<std::pair<int, int> > > in;
+    //true for vertices already contracted
+    std::vector<bool> contracted;
+    std::vector<int> n_contracted_neighbours;
+    //distances of witness search, and vertices they were set for
+    std::vector<int> dists;
+    std::vector<int> touched;
+    //(distance, vertex) heap of witness search
+    std::vector<std::pair<int, int> > heap;
+
+    //Adds edge (u, v), or lowers its cost if it already exists.
+    void add_edge(int u_id, int v_id, int cost)
+    {
+        if(u_id == v_id)
+            return;
+
+        for(unsigned j=0; j<this->out[u_id].size(); j++)
+            if(this->out[u_id][j].first == v_id)
+            {
+                if(cost < this->out[u_id][j].second)
+                {
+                    this->out[u_id][j].second = cost;
+                    for(unsigned k=0; k<this->in[v_id].size(); k++)
+                        if(this->in[v_id][k].first == u_id)
+                            this->in[v_id][k].second = cost;
+                }
+                return;
+            }
+
+        this->out[u_id].push_back(std::make_pair(v_id, cost));
+        this->in[v_id].push_back(std::make_pair(u_id, cost));
+    }
+
+    //Removes connection to v from list conns.
+    static void remove_connection(std::vector<std::pair<int, int> >& conns,
+        int v_id)
+    {
+        for(unsigned j=0; j<conns.size(); j++)
+            if(conns[j].first == v_id)
+            {
+                conns[j] = conns.back();
+                conns.pop_back();
+                return;
+            }
+    }
+
+    //Marks v as contracted, removing it from lists of its neighbours.
+    void remove_vertex(int v_id)
+    {
+        this->contracted[v_id] = true;
+        for(unsigned j=0; j<this->out[v_id].size(); j++)
+            remove_connection(this->in[this->out[v_id][j].first], v_id);
+        for(unsigned j=0; j<this->in[v_id].size(); j++)
+            remove_connection(this->out[this->in[v_id][j].first], v_id);
+    }
+
+    //Gets distances from u among remaining vertices other than v, up to
+    //bound and CH_WITNESS_SETTLED vertices (others keep INF or an upper
+    //bound).
+    void witness_search(int u_id, int v_id, int bound)
+    {
+        std::greater<std::pair<int, int> > heap_less;
+        int n_settled = 0;
+
+        for(unsigned i=0; i<this->touched.size(); i++)
+            this->dists[this->touched[i]] = INF;
+        this->touched.clear();
+        this->heap.clear();
+
+        this->dists[u_id] = 0;
+        this->touched.push_back(u_id);
+        this->heap.push_back(std::make_pair(0, u_id));
+        while(!this->heap.empty())
+        {
+            int dist = this->heap.front().first;
+            int x_id = this->heap.front().second;
+
+            std::pop_heap(this->heap.begin(), this->heap.end(), heap_less);
+            this->heap.pop_back();
+            if(dist > this->dists[x_id])
+                continue;
+            if(dist > bound || ++n_settled > CH_WITNESS_SETTLED)
+                break;
+
+            for(unsigned j=0; j<this->out[x_id].size(); j++)
+            {
+                int y_id = this->out[x_id][j].first;
+                int y_dist = saturated_add(dist, this->out[x_id][j].second);
+
+                if(y_id == v_id || y_dist >= this->dists[y_id])
+                    continue;
+                if(this->dists[y_id] == INF)
+                    this->touched.push_back(y_id);
+                this->dists[y_id] = y_dist;
+                this->heap.push_back(std::make_pair(y_dist, y_id));
+                std::push_heap(this->heap.begin(), this->heap.end(),
+                    heap_less);
+            }
+        }
+    }
+
+    //Gets number of shortcuts needed to contract v, adding them unless
+    //simulate is true.
+    int contract(int v_id, bool simulate)
+    {
+        int n_shortcuts = 0;
+
+        for(unsigned i=0; i<this->in[v_id].size(); i++)
+        {
+            int u_id = this->in[v_id][i].first;
+            int u_cost = this->in[v_id][i].second;
+            int bound = -1;
+
+            for(unsigned j=0; j<this->out[v_id].size(); j++)
+                if(this->out[v_id][j].first != u_id)
+                    bound = std::max(bound,
+                        saturated_add(u_cost, this->out[v_id][j].second));
+            if(bound < 0)
+                continue;
+
+            this->witness_search(u_id, v_id, bound);
+            for(unsigned j=0; j<this->out[v_id].size(); j++)
+            {
+                int w_id = this->out[v_id][j].first;
+                int cost = saturated_add(u_cost, this->out[v_id][j].second);
+
+                if(w_id == u_id || this->dists[w_id] <= cost)
+                    continue;
+                n_shortcuts++;
+                if(!simulate)
+                    this->add_edge(u_id, w_id, cost);
+            }
+        }
+
+        return n_shortcuts;
+    }
+
+    //Gets priority of v for contraction: its edge difference plus number of
+    //neighbours contracted.
+    int priority(int v_id)
+    {
+        return this->contract(v_id, true) -
+            (int)(this->out[v_id].size() + this->in[v_id].size()) +
+            this->n_contracted_neighbours[v_id];
+    }
+};
+
+ContractionHierarchy::ContractionHierarchy(const Graph<int>& graph):
+    n_graph_edges(graph.n_edges()),
+    graph_checksum(ContractionHierarchy::checksum(graph)), valid(false)
+{
+    int min_cost, max_cost;
+
+    graph.forward().cost_range(&min_cost, &max_cost);
+    this->ranks.assign(graph.n_vertices(), 0);
+    if(min_cost < 0)
+        return;
+
+    HierarchyBuilder builder(graph);
+    builder.build(this->ranks, this->us, this->vs, this->costs);
+    this->overlay_graph = Graph<int>(graph.n_vertices(), this->us, this->vs,
+        this->costs);
+    this->valid = true;
+}
+
+//Writes ints of vec to file. Returns false on failure.
+bool write_ints(FILE* file, const std::vector<int>& vec)
+{
+    return vec.empty() ||
+        fwrite(&vec[0], sizeof(int), vec.size(), file) == vec.size();
+}
+
+//Reads vec.size() ints of vec from file. Returns false on failure.
+bool read_ints(FILE* file, std::vector<int>& vec)
+{
+    return vec.empty() ||
+        fread(&vec[0], sizeof(int), vec.size(), file) == vec.size();
+}
+
+uint64_t ContractionHierarchy::checksum(const Graph<int>& graph)
+{
+    //64-bit FNV-1a over the bytes of each (u, v, cost)
+    const uint64_t prime = ((uint64_t)1 << 40) | 0x1b3;
+    const Adjacency<int>& adj = graph.forward();
+    uint64_t hash = ((uint64_t)0xcbf29ce4 << 32) | 0x84222325;
+
+    for(int u_id=0; u_id<graph.n_vertices(); u_id++)
+        for(int j=0; j<adj.n_connections(u_id); j++)
+        {
+            uint32_t words[3] = {(uint32_t)u_id,
+                (uint32_t)adj.get_connection(u_id, j),
+                (uint32_t)adj.get_connection_cost(u_id, j)};
+
+            for(int k=0; k<3; k++)
+                for(int b=0; b<4; b++)
+                {
+                    hash ^= (words[k] >> (8*b)) & 0xff;
+                    hash *= prime;
+                }
+        }
+
+    return hash;
+}
+
+bool ContractionHierarchy::well_formed() const
+{
+    std::vector<bool> ranked(this->n_vertices(), false);
+
+    for(unsigned i=0; i<this->us.size(); i++)
+        if(this->us[i] < 0 || this->us[i] >= this->n_vertices() ||
+            this->vs[i] < 0 || this->vs[i] >= this->n_vertices() ||
+            this->costs[i] < 0)
+            return false;
+
+    //An invalid hierarchy has no ranks nor shortcuts
+    if(!this->valid)
+        return this->us.empty();
+
+    for(int u_id=0; u_id<this->n_vertices(); u_id++)
+    {
+        int r = this->ranks[u_id];
+
+        if(r < 0 || r >= this->n_vertices() || ranked[r])
+            return false;
+        ranked[r] = true;
+    }
+
+    return true;
+}
+
+bool ContractionHierarchy::write(FILE* file) const
+{
+    uint32_t header[6] = {(uint32_t)this->n_vertices(),
+        (uint32_t)this->n_graph_edges, this->valid,
+        (uint32_t)this->us.size(), (uint32_t)this->graph_checksum,
+        (uint32_t)(this->graph_checksum >> 32)};
+
+    return fwrite(header, sizeof(header), 1, file) == 1 &&
+        write_ints(file, this->ranks) && write_ints(file, this->us) &&
+        write_ints(file, this->vs) && write_ints(file, this->costs);
+}
+
+bool ContractionHierarchy::read(FILE* file, const Graph<int>& graph)
+{
+    uint32_t header[6];
+
+    if(fread(header, sizeof(header), 1, file) != 1)
+        return false;
+
+    //Header must match graph before sizing anything by it
+    this->n_graph_edges = (int)header[1];
+    this->graph_checksum = ((uint64_t)header[5] << 32) | header[4];
+    if((int)header[0] != graph.n_vertices() ||
+        this->n_graph_edges != graph.n_edges() ||
+        this->graph_checksum != ContractionHierarchy::checksum(graph) ||
+        header[3] > (uint32_t)std::numeric_limits<int>::max())
+        return false;
+
+    this->valid = header[2] != 0;
+    this->ranks.resize(header[0]);
+    this->us.resize(header[3]);
+    this->vs.resize(header[3]);
+    this->costs.resize(header[3]);
+    if(!read_ints(file, this->ranks) || !read_ints(file, this->us) ||
+        !read_ints(file, this->vs) || !read_ints(file, this->costs) ||
+        !this->well_formed())
+        return false;
+
+    this->overlay_graph = Graph<int>(this->n_vertices(), this->us, this->vs,
+        this->costs);
+
+    return true;
+}
+
+/*
+Class representing distance queries on a contraction hierarchy of a graph.
+A query searches up in rank from source on the overlay and from destination
+on the reverse overlay, alternating between them, until no unsettled
+vertex can be on a shorter path than the best meeting found.
+It also keeps the CH_MAX_CHECKS heaviest edges of the graph, to find
+heaviest edges of paths within limits by distance checks alone.
+*/
+class HierarchyQuery
+{
+    public:
+    //constructor
+    HierarchyQuery(const ContractionHierarchy& ch, const Graph<int>& graph):
+        ch(ch)
+    {
+        const Adjacency<int>& adj = graph.forward();
+
+        for(int d=0; d<2; d++)
+            this->dists[d].assign(ch.n_vertices(), INF);
+
+        for(int u_id=0; u_id<graph.n_vertices(); u_id++)
+            for(int j=0; j<adj.n_connections(u_id); j++)
+                this->heaviest.push_back(std::make_pair(
+                    -adj.get_connection_cost(u_id, j),
+                    std::make_pair(u_id, adj.get_connection(u_id, j))));
+        if(this->heaviest.size() > CH_MAX_CHECKS)
+        {
+            std::partial_sort(this->heaviest.begin(),
+                this->heaviest.begin() + CH_MAX_CHECKS, this->heaviest.end());
+            this->heaviest.resize(CH_MAX_CHECKS);
+        }
+        else
+            std::sort(this->heaviest.begin(), this->heaviest.end());
+    }
+    //destructor
+    ~HierarchyQuery()
+    {;}
+
+    //Gets shortest distance from src to dst, or INF if it exceeds bound.
+    int distance(int src_id, int dst_id, int bound=INF)
+    {
+        std::priority_queue<std::pair<int, int>,
+            std::vector<std::pair<int, int> >,
+            std::greater<std::pair<int, int> > > queues[2];
+        const Adjacency<int>* adjs[2] = {&this->ch.overlay().forward(),
+            &this->ch.overlay().reverse()};
+        int best = INF;
+
+        for(int d=0; d<2; d++)
+        {
+            for(unsigned i=0; i<this->touched[d].size(); i++)
+                this->dists[d][this->touched[d][i]] = INF;
+            this->touched[d].clear();
+        }
+        this->set_dist(0, src_id, 0);
+        this->set_dist(1, dst_id, 0);
+        queues[0].push(std::make_pair(0, src_id));
+        queues[1].push(std::make_pair(0, dst_id));
+
+        while(true)
+        {
+            //direction of smallest key
+            int d = queues[1].empty() || (!queues[0].empty() &&
+                queues[0].top().first <= queues[1].top().first)? 0: 1;
+
+            if(queues[d].empty() ||
+                queues[d].top().first >= std::min(best, bound + 1))
+                break;
+
+            int dist = queues[d].top().first;
+            int u_id = queues[d].top().second;
+            queues[d].pop();
+            if(dist > this->dists[d][u_id])
+                continue;
+            best = std::min(best, saturated_add(dist, this->dists[1-d][u_id]));
+
+            for(int j=0; j<adjs[d]->n_connections(u_id); j++)
+            {
+                int v_id = adjs[d]->get_connection(u_id, j);
+                int v_dist = saturated_add(dist,
+                    adjs[d]->get_connection_cost(u_id, j));
+
+                if(this->ch.rank(v_id) > this->ch.rank(u_id) &&
+                    v_dist < this->dists[d][v_id])
+                {
+                    this->set_dist(d, v_id, v_dist);
+                    queues[d].push(std::make_pair(v_dist, v_id));
+                }
+            }
+        }
+
+        return best <= bound? best: INF;
+    }
+
+    //Looks for heaviest edge in a path from src to dst within limit among
+    //the heaviest edges of graph, checking distances to and from their
+    //endpoints. Returns true and its weight in max_edge_w if one of them
+    //is in such path.
+    bool check_heaviest(int src_id, int dst_id, int path_w_limit,
+        int* max_edge_w)
+    {
+        for(unsigned i=0; i<this->heaviest.size(); i++)
+        {
+            int edge_w = -this->heaviest[i].first;
+            int u_id = this->heaviest[i].second.first;
+            int v_id = this->heaviest[i].second.second;
+            int src_dist, dst_dist;
+
+            //edges of negative weight are never the answer
+            if(edge_w < 0)
+                break;
+
+            src_dist = this->distance(src_id, u_id, path_w_limit - edge_w);
+            if(src_dist == INF)
+                continue;
+            dst_dist = this->distance(v_id, dst_id,
+                path_w_limit - edge_w - src_dist);
+            if(dst_dist == INF)
+                continue;
+
+            *max_edge_w = edge_w;
+            return true;
+        }
+
+        return false;
+    }
+
+    private:
+    const ContractionHierarchy& ch;
+    //distances of forward and backward searches, and vertices they were
+    //set for
+    std::vector<int> dists[2];
+    std::vector<int> touched[2];
+    //(-weight, (u, v)) of heaviest edges, heaviest first
+    std::vector<std::pair<int, std::pair<int, int> > > heaviest;
+
+    //Sets distance of u in search of direction d.
+    void set_dist(int d, int u_id, int dist)
+    {
+        if(this->dists[d][u_id] == INF)
+            this->touched[d].push_back(u_id);
+        this->dists[d][u_id] = dist;
+    }
+};
+
+//max_edge_w_limited_path auxiliar.
+//Gets in max_edge_w heaviest edge in a path from src to dst within limit
+//with contraction hierarchy of options, if there is one and it is enough.
+//Returns false if searches are needed.
+//Contraction hierarchies are only built for int distances.
+template <class dist_type>
+bool hierarchy_max_edge_w(const Graph<dist_type>& graph, int src_id,
+    int dst_id, dist_type path_w_limit, const Options& options,
+    dist_type* max_edge_w)
+{
+    return false;
+}
+bool hierarchy_max_edge_w(const Graph<int>& graph, int src_id, int dst_id,
+    int path_w_limit, const Options& options, int* max_edge_w)
+{
+    if(options.hierarchy == NULL)
+        return false;
+    if(options.hierarchy->distance(src_id, dst_id, path_w_limit) == INF)
+    {
+        *max_edge_w = -1;
+        return true;
+    }
+
+    return options.hierarchy->check_heaviest(src_id, dst_id, path_w_limit,
+        max_edge_w);
+}
+
+//Returns heaviest edge in a path from src to dst vertices not exceding
+//limit weight.
+//Searches only go as far as limit, since farther vertices are in no path
+//within it. The search from dst follows the reverse adjacency of graph.
+//With more than one thread, both searches run at the same time.
+//With a contraction hierarchy, dst farther than limit and a path through
+//one of the heaviest edges of graph are found without searches.
+template <class dist_type>
+dist_type max_edge_w_limited_path(const Graph<dist_type>& graph,
+    int src_id, int dst_id, dist_type path_w_limit, const Options& options)
+{
+    dist_type max_edge_w;
+
+    if(hierarchy_max_edge_w(graph, src_id, dst_id, path_w_limit, options,
+        &max_edge_w))
+        return max_edge_w;
+
+    //shortest paths of graph and transposed graph
+    DijkstraSearch<dist_type> search = {&graph.forward(), src_id, &options,
+        path_w_limit, DijkstraResults<dist_type>()};
+    DijkstraSearch<dist_type> t_search = {&graph.reverse(), dst_id, &options,
+        path_w_limit, DijkstraResults<dist_type>()};
+
+    run_dijkstra_searches(&search, &t_search, options);
+
+    return _max_edge_w_limited_path(graph, path_w_limit,
+        search.res.dists, t_search.res.dists);
+}
+
+//Struct of a query of batch mode.
+struct Query
+{
+    int src_id;
+    int dst_id;
+    int path_w_limit;
+    //position of query in batch
+    int id;
+};
+
+//Ordering of queries by source, destination and limit.
+bool query_less(const Query& a, const Query& b)
+{
+    if(a.src_id != b.src_id)
+        return a.src_id < b.src_id;
+    if(a.dst_id != b.dst_id)
+        return a.dst_id < b.dst_id;
+    return a.path_w_limit < b.path_w_limit;
+}
+
+/*
+Class representing a cache of distance arrays of searches, by root.
+Beyond capacity, the oldest array is dropped.
+*/
+class DistanceCache
+{
+    public:
+    //constructor
+    DistanceCache(int capacity):
+        capacity(capacity)
+    {;}
+    //destructor
+    ~DistanceCache()
+    {;}
+
+    //Gets distances from root (NULL if not in cache).
+    const std::vector<int>* find(int root) const
+    {
+        std::map<int, std::vector<int> >::const_iterator it =
+            this->entries.find(root);
+
+        return it == this->entries.end()? NULL: &it->second;
+    }
+
+    //Inserts distances from root, taking contents of dists.
+    const std::vector<int>& insert(int root, std::vector<int>& dists)
+    {
+        if((int)this->order.size() >= this->capacity)
+        {
+            this->entries.erase(this->order.front());
+            this->order.pop_front();
+        }
+        this->order.push_back(root);
+        this->entries[root].swap(dists);
+
+        return this->entries[root];
+    }
+
+    private:
+    int capacity;
+    //arrays in cache and their roots, oldest first
+    std::map<int, std::vector<int> > entries;
+    std::deque<int> order;
+};
+
+//Gets heaviest edges for each of limits (in increasing order) of paths
+//from src to dst, given distances from src in graph and to dst.
+//With many limits, edges in paths within largest limit are sorted by
+//weight of their shortest path, and limits are answered by binary search
+//on the prefix maxima of edge weights.
+void _max_edge_w_limited_paths(const Graph<int>& graph,
+    const std::vector<int>& path_w_limits,
+    const std::vector<int>& graph_dists, const std::vector<int>& t_graph_dists,
+    std::vector<int>& max_edge_ws)
+{
+    const Adjacency<int>& adj = graph.forward();
+    //(weight of shortest path through edge, edge weight) pairs
+    std::vector<std::pair<int, int> > paths;
+
+    max_edge_ws.resize(path_w_limits.size());
+    if(path_w_limits.size() == 1)
+    {
+        max_edge_ws[0] = _max_edge_w_limited_path(graph, path_w_limits[0],
+            graph_dists, t_graph_dists);
+        return;
+    }
+
+    //edges with an endpoint at distance INF (not reached) are in no path
+    for(int u_id=0; u_id<graph.n_vertices(); u_id++)
+        for(int j=0; j<adj.n_connections(u_id); j++)
+        {
+            int v_id = adj.get_connection(u_id, j);
+            int edge_w = adj.get_connection_cost(u_id, j);
+
+            if(graph_dists[u_id] >= INF || t_graph_dists[v_id] >= INF)
+                continue;
+
+            int path_w = saturated_add(saturated_add(graph_dists[u_id],
+                edge_w), t_graph_dists[v_id]);
+
+            if(path_w <= path_w_limits.back())
+                paths.push_back(std::make_pair(path_w, edge_w));
+        }
+    std::sort(paths.begin(), paths.end());
+    for(unsigned i=1; i<paths.size(); i++)
+        paths[i].second = std::max(paths[i].second, paths[i-1].second);
+
+    for(unsigned i=0; i<path_w_limits.size(); i++)
+    {
+        int n_paths = (int)(std::upper_bound(paths.begin(), paths.end(),
+            std::make_pair(path_w_limits[i], std::numeric_limits<int>::max()))
+            - paths.begin());
+
+        max_edge_ws[i] = n_paths == 0? -1: std::max(-1,
+            paths[n_paths-1].second);
+    }
+}
+
+//Returns heaviest edge in a path within limit for each query, answering
+//all of them on the same graph.
+//Queries are grouped by (src, dst), so each pair is handled once for all
+//its limits. Distance arrays from sources and to destinations are cached,
+//each one from a search up to the largest limit of queries using it.
+//With a contraction hierarchy, pairs farther apart than their largest
+//limit need no searches.
+std::vector<int> max_edge_w_limited_paths(const Graph<int>& graph,
+    const std::vector<Query>& queries, const Options& options)
+{
+    std::vector<Query> sorted(queries);
+    std::vector<int> max_edge_ws(queries.size());
+    //largest limit of queries from each source and to each destination
+    std::map<int, int> src_limits, dst_limits;
+    DistanceCache dists_cache(DIST_CACHE_SIZE);
+    DistanceCache t_dists_cache(DIST_CACHE_SIZE);
+    std::vector<int> limits, group_max_edge_ws;
+
+    std::sort(sorted.begin(), sorted.end(), query_less);
+    for(unsigned i=0; i<sorted.size(); i++)
+    {
+        const Query& query = sorted[i];
+
+        if(src_limits.count(query.src_id) == 0 ||
+            src_limits[query.src_id] < query.path_w_limit)
+            src_limits[query.src_id] = query.path_w_limit;
+        if(dst_limits.count(query.dst_id) == 0 ||
+            dst_limits[query.dst_id] < query.path_w_limit)
+            dst_limits[query.dst_id] = query.path_w_limit;
+    }
+
+    for(unsigned begin=0, end=0; begin<sorted.size(); begin=end)
+    {
+        int src_id = sorted[begin].src_id;
+        int dst_id = sorted[begin].dst_id;
+
+        //queries of pair
+        limits.clear();
+        for(end=begin; end<sorted.size() && sorted[end].src_id == src_id &&
+            sorted[end].dst_id == dst_id; end++)
+            limits.push_back(sorted[end].path_w_limit);
+
+        if(options.hierarchy != NULL && options.hierarchy->distance(src_id,
+            dst_id, limits.back()) == INF)
+        {
+            for(unsigned i=begin; i<end; i++)
+                max_edge_ws[sorted[i].id] = -1;
+            continue;
+        }
+
+        //searches missing from caches
+        const std::vector<int>* dists = dists_cache.find(src_id);
+        const std::vector<int>* t_dists = t_dists_cache.find(dst_id);
+        DijkstraSearch<int> search = {&graph.forward(), src_id, &options,
+            src_limits[src_id], DijkstraResults<int>()};
+        DijkstraSearch<int> t_search = {&graph.reverse(), dst_id, &options,
+            dst_limits[dst_id], DijkstraResults<int>()};
+
+        run_dijkstra_searches(dists == NULL? &search: NULL,
+            t_dists == NULL? &t_search: NULL, options);
+        if(dists == NULL)
+            dists = &dists_cache.insert(src_id, search.res.dists);
+        if(t_dists == NULL)
+            t_dists = &t_dists_cache.insert(dst_id, t_search.res.dists);
+
+        _max_edge_w_limited_paths(graph, limits, *dists, *t_dists,
+            group_max_edge_ws);
+        for(unsigned i=begin; i<end; i++)
+            max_edge_ws[sorted[i].id] = group_max_edge_ws[i-begin];
+    }
+
+    return max_edge_ws;
+}
+
+//Reads values from stdin and builds graph.
+//Costs above infinite distance are lowered to it, since no path within a
+//limit goes through them.
+//Returns false if a cost is below minus infinite distance.
+template <class num_type>
+bool fill_graph(int n_vertices, int n_edges, Graph<num_type>& graph)
+{
+    std::vector<int> us(n_edges), vs(n_edges);
+    std::vector<num_type> costs(n_edges);
+    int64_t cost;
+
+    for(int i=0; i<n_edges; i++)
+    {
+        std::cin >> us[i];
+        std::cin >> vs[i];
+        std::cin >> cost;
+        if(cost < -(int64_t)dist_inf<num_type>())
+            return false;
+        costs[i] = (num_type)std::min(cost,
+            (int64_t)dist_inf<num_type>());
+    }
+
+    graph = Graph<num_type>(n_vertices, us, vs, costs);
+
+    return true;
+}
+
+using namespace std;
+
+//usage: lab_4 [--engine=dijkstra|delta]
+//  [--heap=binary|4-ary|8-ary|pairing|aligned|radix|dial]
+//  [--threads=N] [--delta=N] [--queries] [--write-ch=FILE] [--ch=FILE]
+//  [--int64]
+//--engine: shortest paths algorithm, dijkstra or delta-stepping. default is
+//  dijkstra.
+//--heap: priority queue of dijkstra. radix and dial are monotone integer
+//  queues (dial when costs are small, radix otherwise). default is binary.
+//--threads: number of threads of each query. with 2 or more, dijkstra
+//  searches from source and destination run at the same time, and each
+//  delta-stepping search is split among them. default is 1.
+//--delta: bucket width of delta-stepping. default is picked from the graph.
+//--queries: each case is 'n_vertices n_edges n_queries' followed by the
+//  edges and by the queries, one 'src dst points_limit' per line. one line
+//  is printed for each query.
+//--write-ch: contraction hierarchies of the graphs of cases are built and
+//  written to FILE.
+//--ch: contraction hierarchies of the graphs of cases (as written with
+//  --write-ch) are read from FILE and used to answer queries with distance
+//  checks when possible.
+//--int64: costs, limits and distances are 64-bit integers instead of 32-bit
+//  ones. searches always use dijkstra, and batch queries and contraction
+//  hierarchies are not supported.
+//distances saturate at infinite (about 5.4e8, or 2.3e18 with --int64)
+//instead of overflowing. costs and limits above it are lowered to it, and
+//a cost below minus infinite is an error.
+int main(int argc, char** argv)
+{
+    int n_test_cases;
+    int n_vertices, n_edges, src_id, dst_id;
+    int64_t points_limit;
+    int n_queries;
+    int64_t query_limit;
+    int best;
+    Options options;
+    string write_ch_path, ch_path;
+    FILE* ch_file = NULL;
+    char magic[4];
+    //version and number of cases of contraction hierarchy file
+    uint32_t ch_header[2];
+
+    for(int i=1; i<argc; i++)
+    {
+        string arg = argv[i];
+
+        if(arg == "--engine=dijkstra")
+            options.engine = DIJKSTRA;
+        else if(arg == "--engine=delta")
+            options.engine = DELTA_STEPPING;
+        else if(arg.find("--heap=") == 0 &&
+            heap_kind(arg.substr(string("--heap=").size())) >= 0)
+            options.heap = heap_kind(arg.substr(string("--heap=").size()));
+        else if(arg.find("--heap=") == 0 &&
+            monotone_queue_kind(arg.substr(string("--heap=").size())) >= 0)
+            options.heap =
+                monotone_queue_kind(arg.substr(string("--heap=").size()));
+        else if(arg.find("--threads=") == 0 &&
+            atoi(arg.c_str() + string("--threads=").size()) > 0)
+            options.n_threads = atoi(arg.c_str() +
+                string("--threads=").size());
+        else if(arg.find("--delta=") == 0 &&
+            atoi(arg.c_str() + string("--delta=").size()) > 0)
+            options.delta = atoi(arg.c_str() + string("--delta=").size());
+        else if(arg == "--queries")
+            options.batch = true;
+        else if(arg.find("--write-ch=") == 0 &&
+            arg.size() > string("--write-ch=").size())
+            write_ch_path = arg.substr(string("--write-ch=").size());
+        else if(arg.find("--ch=") == 0 &&
+            arg.size() > string("--ch=").size())
+            ch_path = arg.substr(string("--ch=").size());
+        else if(arg == "--int64")
+            options.int64 = true;
+        else
+        {
+            cerr << "invalid argument '" << arg << "'" << endl;
+            return 1;
+        }
+    }
+
+    if(options.int64 && (options.batch || !write_ch_path.empty() ||
+        !ch_path.empty()))
+    {
+        cerr << "--int64 does not support --queries, --write-ch nor --ch"
+            << endl;
+        return 1;
+    }
+
+    ThreadPool pool(options.engine == DELTA_STEPPING? options.n_threads: 1);
+    options.pool = &pool;
+
+    cin >> n_test_cases;
+    if(!write_ch_path.empty())
+    {
+        ch_file = fopen(write_ch_path.c_str(), "wb");
+        ch_header[0] = CH_FILE_VERSION;
+        ch_header[1] = n_test_cases;
+        if(ch_file == NULL || fwrite(CH_FILE_MAGIC, 4, 1, ch_file) != 1 ||
+            fwrite(ch_header, sizeof(ch_header), 1, ch_file) != 1)
+        {
+            cerr << "could not write '" << write_ch_path << "'" << endl;
+            return 1;
+        }
+    }
+    else if(!ch_path.empty())
+    {
+        ch_file = fopen(ch_path.c_str(), "rb");
+        if(ch_file == NULL || fread(magic, 4, 1, ch_file) != 1 ||
+            memcmp(magic, CH_FILE_MAGIC, 4) != 0 ||
+            fread(ch_header, sizeof(ch_header), 1, ch_file) != 1 ||
+            ch_header[0] != CH_FILE_VERSION ||
+            (int)ch_header[1] != n_test_cases)
+        {
+            cerr << "invalid contraction hierarchy file '" << ch_path << "'"
+                << endl;
+            return 1;
+        }
+    }
+
+    for(int i=0; i<n_test_cases; i++)
+    {
+        cin >> n_vertices;
+        cin >> n_edges;
+        if(options.batch)
+            cin >> n_queries;
+        else
+        {
+            cin >> src_id;
+            cin >> dst_id;
+            cin >> points_limit;
+        }
+
+        if(options.int64)
+        {
+            Graph<int64_t> graph;
+
+            if(!fill_graph(n_vertices, n_edges, graph))
+            {
+                cerr << "cost out of range in case " << i << endl;
+                return 1;
+            }
+            cout << max_edge_w_limited_path(graph, src_id, dst_id,
+                clamp_limit<int64_t>(points_limit), options) << endl;
+            continue;
+        }
+
+        Graph<int> graph;
+        ContractionHierarchy ch;
+
+        if(!fill_graph(n_vertices, n_edges, graph))
+        {
+            cerr << "cost out of range in case " << i << endl;
+            return 1;
+        }
+
+        if(!write_ch_path.empty())
+        {
+            ch = ContractionHierarchy(graph);
+            if(!ch.write(ch_file))
+            {
+                cerr << "could not write '" << write_ch_path << "'" << endl;
+                return 1;
+            }
+        }
+        else if(!ch_path.empty())
+        {
+            if(!ch.read(ch_file, graph))
+            {
+                cerr << "contraction hierarchy of case " << i
+                    << " does not match its graph" << endl;
+                return 1;
+            }
+            if(ch.is_valid())
+                options.hierarchy = new HierarchyQuery(ch, graph);
+        }
+
+        if(options.batch)
+        {
+            vector<Query> queries(n_queries);
+
+            for(int j=0; j<n_queries; j++)
+            {
+                cin >> queries[j].src_id;
+                cin >> queries[j].dst_id;
+                cin >> query_limit;
+                queries[j].path_w_limit = clamp_limit<int>(query_limit);
+                queries[j].id = j;
+            }
+
+            vector<int> bests = max_edge_w_limited_paths(graph, queries,
+                options);
+            for(int j=0; j<n_queries; j++)
+                cout << bests[j] << endl;
+        }
+        else
+        {
+            best = max_edge_w_limited_path(graph, src_id, dst_id,
+                clamp_limit<int>(points_limit), options);
+            cout << best << endl;
+        }
+
+        delete options.hierarchy;
+        options.hierarchy = NULL;
+    }
+
+    if(ch_file != NULL)
+        fclose(ch_file);
+
     return 0;
 }
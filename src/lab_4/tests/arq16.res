@@ -0,0 +1,5 @@
+30
+4
+-1
+-1
+9
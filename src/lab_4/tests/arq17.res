@@ -0,0 +1,4 @@
+-1
+4
+4
+6
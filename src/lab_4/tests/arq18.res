@@ -0,0 +1,3 @@
+5
+1048576
+3
@@ -0,0 +1,3 @@
+4
+90000
+48
@@ -0,0 +1,147 @@
+10
+-1
+10
+-1
+-1
+10
+9
+-1
+-1
+-1
+-1
+-1
+-1
+10
+-1
+-1
+-1
+-1
+-1
+10
+10
+10
+10
+-1
+-1
+-1
+-1
+-1
+10
+-1
+10
+-1
+-1
+-1
+10
+-1
+-1
+-1
+-1
+9
+-1
+-1
+-1
+-1
+-1
+10
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+982
+661
+661
+-1
+982
+661
+982
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+601254
+-1
+987894
+796359
+-1
+-1
+-1
+-1
+-1
+-1
+816611
+987894
+-1
+987894
+987894
+987894
+-1
+-1
+987894
+983450
+987894
+-1
+601254
+987894
+-1
+987894
+-1
+987894
+-1
+-1
+987894
+-1
+-1
+-1
+987894
+-1
+-1
+-1
+-1
+268
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
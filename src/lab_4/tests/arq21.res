@@ -0,0 +1,4 @@
+6
+0
+9
+11
@@ -0,0 +1,13 @@
+-1
+2
+30
+2
+30
+2
+3
+4
+4
+-1
+5
+1
+5
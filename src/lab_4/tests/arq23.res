@@ -0,0 +1,30 @@
+-1
+-1
+995119261255
+99969794753754835
+998683435
+994413980261267
+998824654
+-1
+868099064
+-1
+-1
+993879477519
+-1
+998013524867498
+998131198001408
+-1
+970003791
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+-1
+992528534851954
+-1
@@ -0,0 +1,3 @@
+-1
+5
+9
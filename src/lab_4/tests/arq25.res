@@ -0,0 +1,3 @@
+-1
+536000000
+12
@@ -0,0 +1,9 @@
+1
+1
+-1
+4
+7
+100
+-1
+100
+-1
@@ -0,0 +1 @@
+contraction hierarchy of case 0 does not match its graph
@@ -3,12 +3,9 @@
 #include <vector>
 #include <iostream>
 #include <list>
-#include <queue>
 
 using namespace std;
 
-//default edge cost if no edge is found
-#define DEF_EDGE_COST 0
 //default int value for none
 #define NONE (-1)
 //character for alpha sector
@@ -45,40 +42,6 @@ class Graph
         this->nodes[u_id].push_back(make_pair(v_id, val));
     }
 
-    //Removes edge (u, v) from graph.
-    void del_edge(int u_id, int v_id)
-    {
-        list<pair<int, int> >::iterator it;
-        for(it=this->nodes[u_id].begin(); it!=this->nodes[u_id].end(); ++it)
-            if((*it).first == v_id)
-            {
-                this->nodes[u_id].erase(it);
-                break;
-            }
-    }
-
-    //Returns true iff edge (u, v) exists in graph.
-    bool has_edge(int u_id, int v_id) const
-    {
-        adj_list_it_t it;
-        for(it=this->nodes[u_id].begin(); it!=this->nodes[u_id].end(); ++it)
-            if((*it).first == v_id)
-                return true;
-
-        return false;
-    }
-
-    //Gets cost of edge (u, v).
-    int get_edge_cost(int u_id, int v_id) const
-    {
-        adj_list_it_t it;
-        for(it=this->nodes[u_id].begin(); it!=this->nodes[u_id].end(); ++it)
-            if((*it).first == v_id)
-                return (*it).second;
-
-        return DEF_EDGE_COST;
-    }
-
     //Gets iterator to beginning of adjacency list of node u.
     adj_list_it_t adj_list_begin(int u_id) const
     {
@@ -109,141 +72,192 @@ void swap(int* x, int* y)
     *y = aux;
 }
 
-//Breadth-first search customized to get a path from src to dst.
-vector<int> bfs(const Graph& graph, int src_id, int dst_id)
+/*
+Class representing the residual net of a flow network.
+Edges are kept in flat arrays, those leaving node u at positions
+[starts[u], starts[u+1]). Each edge of the network comes with a reverse
+edge of capacity zero, and both store the position of the other, so
+pushing flow along an edge is an in-place update of their residual
+capacities.
+*/
+class ResidualNet
 {
-    queue<int> q;
-    vector<bool> visited(graph.n_nodes(), false);
-    vector<int> pi(graph.n_nodes(), NONE);
-
-    visited[src_id] = true;
-    q.push(src_id);
-
-    while(!q.empty())
+    public:
+    //constructor
+    ResidualNet(const Graph& caps):
+        starts(caps.n_nodes()+1, 0)
     {
-        int u_id = q.front();
-        q.pop();
+        int n_edges = 0;
 
-        adj_list_it_t it;
-        for(it=graph.adj_list_begin(u_id); it!=graph.adj_list_end(u_id); ++it)
+        //counting edges leaving each node (including reverse ones)
+        for(int u_id=0; u_id<caps.n_nodes(); u_id++)
         {
-            int v_id = (*it).first;
-
-            if(!visited[v_id])
+            adj_list_it_t it;
+            for(it=caps.adj_list_begin(u_id); it!=caps.adj_list_end(u_id);
+                ++it)
             {
-                pi[v_id] = u_id;
-                visited[v_id] = true;
-                q.push(v_id);
-                if(v_id == dst_id)
-                    return pi;
+                this->starts[u_id+1]++;
+                this->starts[(*it).first+1]++;
+                n_edges += 2;
+            }
+        }
+        for(int u_id=0; u_id<caps.n_nodes(); u_id++)
+            this->starts[u_id+1] += this->starts[u_id];
+
+        //placing each edge along with its reverse
+        vector<int> cursors(this->starts.begin(), this->starts.end()-1);
+        this->heads.resize(n_edges);
+        this->res_caps.resize(n_edges);
+        this->revs.resize(n_edges);
+        for(int u_id=0; u_id<caps.n_nodes(); u_id++)
+        {
+            adj_list_it_t it;
+            for(it=caps.adj_list_begin(u_id); it!=caps.adj_list_end(u_id);
+                ++it)
+            {
+                int v_id = (*it).first;
+                int e = cursors[u_id]++;
+                int rev_e = cursors[v_id]++;
+
+                this->heads[e] = v_id;
+                this->res_caps[e] = (*it).second;
+                this->revs[e] = rev_e;
+                this->heads[rev_e] = u_id;
+                this->res_caps[rev_e] = 0;
+                this->revs[rev_e] = e;
             }
         }
     }
+    //destructor
+    ~ResidualNet()
+    {;}
 
-    return pi;
-}
+    //Returns number of nodes in net.
+    int n_nodes() const
+    {
+        return (int)this->starts.size() - 1;
+    }
+
+    //Gets position of first edge leaving node u.
+    int edges_begin(int u_id) const
+    {
+        return this->starts[u_id];
+    }
 
-//Gets residual net from flow.
-Graph residual_net(const Graph& flow, const Graph& caps)
+    //Gets position after last edge leaving node u.
+    int edges_end(int u_id) const
+    {
+        return this->starts[u_id+1];
+    }
+
+    //Gets node edge e goes to.
+    int head(int e) const
+    {
+        return this->heads[e];
+    }
+
+    //Gets node edge e leaves.
+    int tail(int e) const
+    {
+        return this->heads[this->revs[e]];
+    }
+
+    //Gets residual capacity of edge e.
+    int res_cap(int e) const
+    {
+        return this->res_caps[e];
+    }
+
+    //Pushes amount of flow along edge e.
+    void push(int e, int amount)
+    {
+        this->res_caps[e] -= amount;
+        this->res_caps[this->revs[e]] += amount;
+    }
+
+    private:
+    //position of first edge of each node (and total at the end)
+    vector<int> starts;
+    //node each edge goes to, its residual capacity and its reverse edge
+    vector<int> heads;
+    vector<int> res_caps;
+    vector<int> revs;
+};
+
+//Breadth-first search customized to get a path from src to dst.
+//Gets in pi the edge through which each node was reached (NONE if it was
+//not), using queue as buffer.
+void bfs(const ResidualNet& res_net, int src_id, int dst_id,
+    vector<int>& pi, vector<int>& queue)
 {
-    Graph res_net = Graph(flow.n_nodes());
+    pi.assign(res_net.n_nodes(), NONE);
+    queue.clear();
+    queue.push_back(src_id);
 
-    for(int u_id=0; u_id<caps.n_nodes(); u_id++)
+    for(unsigned head=0; head<queue.size(); head++)
     {
-        adj_list_it_t it;
-        for(it=caps.adj_list_begin(u_id); it!=caps.adj_list_end(u_id); ++it)
+        int u_id = queue[head];
+
+        for(int e=res_net.edges_begin(u_id); e<res_net.edges_end(u_id); e++)
         {
-            int v_id = (*it).first;
-            int cap = (*it).second;
-            int flux = flow.get_edge_cost(u_id, v_id);
-
-            if(cap - flux > 0)
-                res_net.add_edge(u_id, v_id, cap - flux);
-            if(flux > 0)
-                res_net.add_edge(v_id, u_id, flux);
+            int v_id = res_net.head(e);
+
+            if(res_net.res_cap(e) > 0 && pi[v_id] == NONE && v_id != src_id)
+            {
+                pi[v_id] = e;
+                queue.push_back(v_id);
+                if(v_id == dst_id)
+                    return;
+            }
         }
     }
-
-    return res_net;
 }
 
 //Gets residual capacity of path from src to dst given by pi.
-int residual_capacity(const Graph& res_net,
+int residual_capacity(const ResidualNet& res_net,
     const vector<int>& pi, int src_id, int dst_id)
 {
-    int v_id = dst_id;
-    int res_cap = res_net.get_edge_cost(pi[v_id], v_id);
+    int res_cap = res_net.res_cap(pi[dst_id]);
 
-    for(v_id=pi[v_id]; v_id!=src_id; v_id=pi[v_id])
-    {
-        int cap = res_net.get_edge_cost(pi[v_id], v_id);
-        if(cap < res_cap)
-            res_cap = cap;
-    }
+    for(int v_id=dst_id; v_id!=src_id; v_id=res_net.tail(pi[v_id]))
+        if(res_net.res_cap(pi[v_id]) < res_cap)
+            res_cap = res_net.res_cap(pi[v_id]);
 
     return res_cap;
 }
 
 //Augments flow. Assumes there is a path from src to dst in pi.
-void augment_flow(Graph& flow, Graph& res_net,
+//Returns amount of flow pushed.
+int augment_flow(ResidualNet& res_net,
         const vector<int>& pi, int src_id, int dst_id)
 {
     int res_cap = residual_capacity(res_net, pi, src_id, dst_id);
 
-    for(int v_id=dst_id; v_id!=src_id; v_id=pi[v_id])
-    {
-        int u_id = pi[v_id];
-        int new_flow;
-        bool rev = flow.has_edge(v_id, u_id);
-
-        //updating residual net
-        int old_cap_1 = res_net.get_edge_cost(u_id, v_id);
-        int old_cap_2 = res_net.get_edge_cost(v_id, u_id);
-        res_net.del_edge(u_id, v_id);
-        res_net.del_edge(v_id, u_id);
-        if(old_cap_1 - res_cap > 0)
-            res_net.add_edge(u_id, v_id, old_cap_1 - res_cap);
-        if(old_cap_2 + res_cap > 0)
-            res_net.add_edge(v_id, u_id, old_cap_2 + res_cap);
-
-        if(rev)
-            new_flow = flow.get_edge_cost(v_id, u_id) - res_cap;
-        else
-            new_flow = flow.get_edge_cost(u_id, v_id) + res_cap;
-
-        flow.del_edge(rev?v_id:u_id, rev?u_id:v_id);
-        if(new_flow > 0)
-            flow.add_edge(rev?v_id:u_id, rev?u_id:v_id, new_flow);
-    }
+    for(int v_id=dst_id; v_id!=src_id; v_id=res_net.tail(pi[v_id]))
+        res_net.push(pi[v_id], res_cap);
+
+    return res_cap;
 }
 
-//Gets maximum flow using bfs (a.k.a. edmonds karp).
-void edmonds_karp(Graph& flow, const Graph& capacities, int src_id, int dst_id)
+//Gets maximum flow using bfs (a.k.a. edmonds karp), leaving it in res_net.
+//Returns flow value.
+int edmonds_karp(ResidualNet& res_net, int src_id, int dst_id)
 {
-    Graph res_net = residual_net(flow, capacities);
+    //edges of paths found by bfs and its queue, reused by all searches
+    vector<int> pi, queue;
+    int flow_val = 0;
 
     while(true)
     {
-        vector<int> pi = bfs(res_net, src_id, dst_id);
+        bfs(res_net, src_id, dst_id, pi, queue);
 
         if(pi[dst_id] == NONE)
             break;
 
-        augment_flow(flow, res_net, pi, src_id, dst_id);
+        flow_val += augment_flow(res_net, pi, src_id, dst_id);
     }
-}
-
-//Gets flow value on node src.
-int flow_val(const Graph& flow, int src_id)
-{
-    int val = 0;
-
-    for(int i=0; i<flow.n_nodes(); i++)
-        val -= flow.get_edge_cost(i, src_id);
-    for(int i=0; i<flow.n_nodes(); i++)
-        val += flow.get_edge_cost(src_id, i);
 
-    return val;
+    return flow_val;
 }
 
 //Reads char matrix from stdin in boolean matrix format.
@@ -335,7 +349,6 @@ Graph reduce(const vector<vector<bool> >& mat)
                         if(!left)
                             swap(&u_id, &v_id);
 
-                        //if(!bipartition.has_edge(0, u_id))
                         if(!src_to_node[u_id])
                         {
                             bipartition.add_edge(0, u_id, 1);
@@ -356,9 +369,9 @@ Graph reduce(const vector<vector<bool> >& mat)
 }
 
 //Transforms solution from maximum matching into solution to fitting rectangles.
-int solution_transform(Graph& flow, const Graph& cap)
+int solution_transform(const ResidualNet& res_net, int flow_val)
 {
-    return (flow.n_nodes()-2) - flow_val(flow, 0);
+    return (res_net.n_nodes()-2) - flow_val;
 }
 
 //Solves rectangles fitting problem.
@@ -372,13 +385,13 @@ void solve()
 
     //reducing problem
     Graph caps = reduce(mat);
-    Graph flow(caps.n_nodes());
+    ResidualNet res_net(caps);
 
     //solving
-    edmonds_karp(flow, caps, 0, flow.n_nodes()-1);
+    int flow_val = edmonds_karp(res_net, 0, res_net.n_nodes()-1);
 
     //applying transformation
-    sol = solution_transform(flow, caps);
+    sol = solution_transform(res_net, flow_val);
     cout << sol << endl;
 }
 
@@ -2,6 +2,7 @@
 
 #test.sh -- batch testing for programs
 #usage: ./test.sh <dir_of_program> <program_name>
+#if tests/<case>.args exists, its contents are passed to the program.
 
 dir=$1
 program=$2
@@ -23,9 +24,13 @@ for test_case in ./$test_dir/*.in; do
 	echo "--- in $test_case ---"
 
 	expected=$(echo $test_case | rev | cut -f1 -d. --complement | rev).res
+	#optional command-line arguments for the test case
+	args_file=$(echo $test_case | rev | cut -f1 -d. --complement | rev).args
+	args=""
+	[ -f "$args_file" ] && args=$(cat $args_file)
 
 	echo "program output:"
-	{ $cmd ./$(basename $program) < $test_case; } &> $out
+	{ $cmd ./$(basename $program) $args < $test_case; } &> $out
 	cat -- $out
 
 	if [[ -z "$(diff $out $expected)" ]]; then